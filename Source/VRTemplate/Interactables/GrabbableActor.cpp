@@ -16,6 +16,7 @@
 #include "Project/SimpleTimeline.h"
 #include "Project/VRFunctionLibrary.h"
 #include "Project/EffectsContainer.h"
+#include "Project/AudioVoicePool.h"
 #include "Kismet/GameplayStatics.h"
 #include <Sound/SoundBase.h>
 #include <Components/AudioComponent.h>
@@ -204,9 +205,16 @@ void AGrabbableActor::OnHit(AActor* SelfActor, AActor* OtherActor, FVector Norma
 						lastImpactSoundTime = GetWorld()->GetTimeSeconds();
 						lastRumbleIntensity = rumbleIntesity;
 
-						// Adjust the audio and Play sound effect.
-						grabbableAudio->SetVolumeMultiplier(rumbleIntesity);
-						grabbableAudio->Play();
+						// Play sound effect through the voice pool, impacts can come from piles of grabbables so are low priority.
+						if (AAudioVoicePool* voicePool = AAudioVoicePool::Get(GetWorld()))
+						{
+							voicePool->PlaySound(grabbableAudio->Sound, grabbableMesh->GetComponentLocation(), rumbleIntesity, 1.0f, EAudioVoicePriority::Low, grabbableMesh);
+						}
+						else
+						{
+							grabbableAudio->SetVolumeMultiplier(rumbleIntesity);
+							grabbableAudio->Play();
+						}
 
 						// Set timer to set lastRumbleIntensity back to 0.0f once the sound has played.
 						FTimerDelegate timerDel;
@@ -236,9 +244,10 @@ void AGrabbableActor::Tick(float DeltaTime)
 void AGrabbableActor::PickupAttatchTo()
 {
 	// Disable physics and attach component to the controller with the static method.
+	// NOTE: Attached to the hands predicted root so it follows the same pose prediction as the hand mesh.
 	grabbableMesh->SetSimulatePhysics(false);
 	FAttachmentTransformRules attatchRules(EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, true);
-	grabbableMesh->AttachToComponent(handRefInfo.targetComponent, attatchRules);
+	grabbableMesh->AttachToComponent(handRefInfo.handRef->predictedRoot, attatchRules);
 
 	// Overlap constrained components to know where to enable physics collision.
 	grabbableMesh->SetCollisionResponseToChannel(ECC_ConstrainedComp, ECR_Overlap);
@@ -270,9 +279,16 @@ void AGrabbableActor::PickupPhysicsHandle(FGrabInformation grabInfo)
 		}
 	}
 
-	// Adjust the audio and Play sound effect.
-	grabbableAudio->SetVolumeMultiplier(rumbleIntesity);
-	grabbableAudio->Play();
+	// Play sound effect through the voice pool.
+	if (AAudioVoicePool* voicePool = AAudioVoicePool::Get(GetWorld()))
+	{
+		voicePool->PlaySound(grabbableAudio->Sound, grabbableMesh->GetComponentLocation(), rumbleIntesity, 1.0f, EAudioVoicePriority::Normal, grabbableMesh);
+	}
+	else
+	{
+		grabbableAudio->SetVolumeMultiplier(rumbleIntesity);
+		grabbableAudio->Play();
+	}
 
 	// Create joint between hand and physics object and enable physics to handle any collisions.
 	FVector locationToGrab = grabInfo.targetComponent->GetComponentLocation();
@@ -457,7 +473,9 @@ FTransform AGrabbableActor::GetGrabbedTransform()
 
 void AGrabbableActor::UpdateGrabInformation()
 {
-	handRefInfo.worldPickupOffset = handRefInfo.targetComponent->GetComponentTransform().TransformPosition(handRefInfo.originalRelativePickupOffset);
+	// Target the predicted pose when attached as the grabbable is following the hands predicted root.
+	const FTransform targetTransform = attatched ? handRefInfo.handRef->GetPredictedTransform(handRefInfo.targetComponent) : handRefInfo.targetComponent->GetComponentTransform();
+	handRefInfo.worldPickupOffset = targetTransform.TransformPosition(handRefInfo.originalRelativePickupOffset);
 	
 	// Check if need to track rotation of second hand.
 	if (interactableSettings.twoHandedGrabbing && otherHandRefInfo.handRef)
@@ -475,7 +493,7 @@ void AGrabbableActor::UpdateGrabInformation()
 		}
 	}
 
-	handRefInfo.worldRotationOffset = handRefInfo.targetComponent->GetComponentTransform().TransformRotation(handRefInfo.originalPickupRelativeRotation.Quaternion()).Rotator();
+	handRefInfo.worldRotationOffset = targetTransform.TransformRotation(handRefInfo.originalPickupRelativeRotation.Quaternion()).Rotator();
 }
 
 void AGrabbableActor::GrabPressed_Implementation(AVRHand* hand)
@@ -688,10 +706,10 @@ void AGrabbableActor::Dragging_Implementation(float deltaTime)
 			}
 		}
 
-		// Update current grabbables velocity change over time.
-		lastFrameVelocity = currentFrameVelocity;
+		// Update current grabbables velocity and velocity change over time from the grabbing hands kinematic history.
+		const FKinematicHistory& handHistory = handRefInfo.handRef->GetKinematicHistory();
 		currentFrameVelocity = handRefInfo.handRef->handVelocity.Size();
-		currentVelocityChange = FMath::Abs((lastFrameVelocity - currentFrameVelocity) / GetWorld()->GetDeltaSeconds());
+		currentVelocityChange = FMath::Abs(handHistory.GetSpeedChange(handRefInfo.handRef->velocityWindow));
 
 		// Handle collisions for collidable grab mode.
 		if (grabMode == EGrabMode::AttatchToWithPhysics)
@@ -800,3 +818,8 @@ void AGrabbableActor::SetInterfaceSettings_Implementation(FHandInterfaceSettings
 {
 	interactableSettings = newInterfaceSettings;
 }
+
+const FHandInterfaceSettings* AGrabbableActor::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
@@ -289,7 +289,6 @@ private:
 	FTransform secondHandOriginalTransform, secondHandGrabbableRot; /** Original second hand grabbed transform of the grabbableMesh. */
 	FTimerHandle lastRumbleHandle;/** Timer handle to allow another rumble within this class when over. */
 	float lastImpactSoundTime, lastRumbleIntensity;
-	float lastFrameVelocity; /** Last frames velocity to help calculate velocity change over time. */
 	float lastHandGrabDistance; /** distance the hand was away from this actor last frame.  */
 	float lerpStartTime; /** Start time of the lerp. */
 	float lastZ;
@@ -379,4 +378,5 @@ public:
 	/**  Get and set functions to allow changes from blueprint. */
 	virtual FHandInterfaceSettings GetInterfaceSettings_Implementation() override;
 	virtual void SetInterfaceSettings_Implementation(FHandInterfaceSettings newInterfaceSettings) override;
+	virtual const FHandInterfaceSettings* GetNativeInterfaceSettings() const override;
 };
@@ -20,6 +20,7 @@
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Project/EffectsContainer.h"
+#include "Project/AudioVoicePool.h"
 #include "Sound/SoundBase.h"
 
 DEFINE_LOG_CATEGORY(LogGrabbableSkelComp);
@@ -141,7 +142,7 @@ void UGrabbableSkelMesh::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
 						lastRumbleIntensity = rumbleIntesity;
 
 						// Play sound effect.
-						UGameplayStatics::PlaySoundAtLocation(GetWorld(), impactSound, GetComponentLocation(), rumbleIntesity);
+						AAudioVoicePool::PlaySoundAtLocation(this, impactSound, GetComponentLocation(), rumbleIntesity, 1.0f, EAudioVoicePriority::Low);
 
 						// Set timer to set lastRumbleIntensity back to 0.0f once the sound has played.
 						FTimerDelegate timerDel;
@@ -321,7 +322,7 @@ void UGrabbableSkelMesh::ToggleSoftPhysicsHandle(bool on)
 			}
 
 			// Play sound effect.
-			UGameplayStatics::PlaySoundAtLocation(GetWorld(), impactSound, GetComponentLocation(), rumbleIntesity);
+			AAudioVoicePool::PlaySoundAtLocation(this, impactSound, GetComponentLocation(), rumbleIntesity);
 
 			// Make current bone act like larger bone, so it effects parent bones correctly when grabbed and in soft constraint mode.
 			if (adjustInertiaFromArray)
@@ -434,7 +435,7 @@ void UGrabbableSkelMesh::GrabReleased_Implementation(AVRHand* hand)
 	DropPhysicsHandle(hand);
 
 	// Update velocity from hand movement when releasing this component. (BUG FIX)
-	SetAllPhysicsLinearVelocity(handRef->handVelocity, false);
+	SetAllPhysicsLinearVelocity(handRef->GetThrowVelocity(), false);
 	SetAllPhysicsAngularVelocityInDegrees(handRef->handAngularVelocity, false);
 
 	// Broadcast released delegate.
@@ -565,3 +566,8 @@ void UGrabbableSkelMesh::SetInterfaceSettings_Implementation(FHandInterfaceSetti
 {
 	interactableSettings = newInterfaceSettings;
 }
+
+const FHandInterfaceSettings* UGrabbableSkelMesh::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
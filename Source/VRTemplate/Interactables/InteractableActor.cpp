@@ -89,6 +89,11 @@ void AInteractableActor::SetInterfaceSettings_Implementation(FHandInterfaceSetti
 	interactableSettings = newInterfaceSettings;
 }
 
+const FHandInterfaceSettings* AInteractableActor::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
+
 void AInteractableActor::GrabbedWhileLocked_Implementation()
 {
 	GrabbedWhileLockedBP();
@@ -5,6 +5,7 @@
 #include "Components/SplineMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "Player/VRHand.h"
+#include "Project/AudioVoicePool.h"
 #include "SceneManagement.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
@@ -448,7 +449,7 @@ void APeelableSplineActor::Dragging_Implementation(float deltaTime)
 		{
 			float intensity = (handRef->handVelocity.Size() - 10.0f) / 50.0f;
 			if (hapticCurve) handRef->PlayFeedback(hapticCurve, intensity, false);
-			if (peelSound) UGameplayStatics::PlaySoundAtLocation(GetWorld(), peelSound, peelableSpline->GetWorldLocationAtSplinePoint(detachedSplineEnd), intensity, intensity);
+			if (peelSound) AAudioVoicePool::PlaySoundAtLocation(this, peelSound, peelableSpline->GetWorldLocationAtSplinePoint(detachedSplineEnd), intensity, intensity);
 		}
 		
 		// Re-generate the spline between the hand, current peel state spline point and the end of the spline.
@@ -467,3 +468,8 @@ void APeelableSplineActor::SetInterfaceSettings_Implementation(FHandInterfaceSet
 	interactableSettings = newInterfaceSettings;
 }
 
+const FHandInterfaceSettings* APeelableSplineActor::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
+
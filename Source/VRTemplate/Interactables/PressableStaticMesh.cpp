@@ -10,6 +10,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Project/VRFunctionLibrary.h"
+#include "Project/AudioVoicePool.h"
 #include "Player/VRHand.h"
 #include "GrabbableActor.h"
 
@@ -243,12 +244,12 @@ void UPressableStaticMesh::UpdateButton(bool isOn)
 			if (AVRHand* foundHand = Cast<AVRHand>(buttonHit.GetActor()))
 			{
 				// If there is a haptic effect use it, otherwise use the default haptic effect (Handled in rumble controller function).
-				foundHand->PlayFeedback(hapticEffect);
+				foundHand->PlayFeedback(hapticEffect, 1.0f, false, EHapticPriority::High);
 			}
 			else if (AGrabbableActor* foundGrabbable = Cast<AGrabbableActor>(buttonHit.GetActor()))
 			{
 				// Otherwise if there is a grabbable find the hand holding the grabbable and play haptic effect.
-				if (AVRHand* hand = foundGrabbable->handRefInfo.handRef) hand->PlayFeedback(hapticEffect);
+				if (AVRHand* hand = foundGrabbable->handRefInfo.handRef) hand->PlayFeedback(hapticEffect, 1.0f, false, EHapticPriority::High);
 			}
 		}
 	}
@@ -258,7 +259,7 @@ void UPressableStaticMesh::UpdateButton(bool isOn)
 	onPressedReff.Broadcast(this);
 
 	// Play on/off audio.
-	UGameplayStatics::PlaySoundAtLocation(GetWorld(), soundToUse, GetComponentLocation(), soundIntensity, soundPitch, 0.0f, soundAttenuation);
+	AAudioVoicePool::PlaySoundAtLocation(this, soundToUse, GetComponentLocation(), soundIntensity, soundPitch, EAudioVoicePriority::High, soundAttenuation);
 	keepingPos = true;
 	alreadyToggled = true;
 
@@ -15,6 +15,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "Project/EffectsContainer.h"
+#include "Project/AudioVoicePool.h"
 
 DEFINE_LOG_CATEGORY(LogRotatable);
 
@@ -460,7 +461,7 @@ void ARotatableActor::UpdateAudioAndHaptics()
 			// Play audio if set and not playing the impact sound currently.
 			if (imapctSoundEnabled && impactSound)
 			{
-				UGameplayStatics::PlaySoundAtLocation(GetWorld(), impactSound, rotatorAudio->GetComponentLocation(), intensity);
+				AAudioVoicePool::PlaySoundAtLocation(this, impactSound, rotatorAudio->GetComponentLocation(), intensity);
 				imapctSoundEnabled = false;
 			}
 		}
@@ -534,7 +535,7 @@ void ARotatableActor::Lock(float lockingAngle)
 		// If lock haptic effect is enable and not null play on hand then release. Also play sound.
 		if (handRef)
 		{
-			if (lockHapticEffect) handRef->PlayFeedback(lockHapticEffect, 1.0f);
+			if (lockHapticEffect) handRef->PlayFeedback(lockHapticEffect, 1.0f, false, EHapticPriority::High);
 			handRef->ReleaseGrabbedActor();
 		}
 
@@ -554,7 +555,7 @@ void ARotatableActor::Lock(float lockingAngle)
 		if (lockSound)
 		{
 			float lockVolume = FMath::Clamp(FMath::Abs(angularVelocity) / 220.0f, 0.4f, 1.5f);
-			UGameplayStatics::PlaySoundAtLocation(GetWorld(), lockSound, rotatorAudio->GetComponentLocation(), lockVolume);
+			AAudioVoicePool::PlaySoundAtLocation(this, lockSound, rotatorAudio->GetComponentLocation(), lockVolume, 1.0f, EAudioVoicePriority::High);
 		}
 
 		// Log.
@@ -847,3 +848,8 @@ void ARotatableActor::SetInterfaceSettings_Implementation(FHandInterfaceSettings
 {
 	interactableSettings = newInterfaceSettings;
 }
+
+const FHandInterfaceSettings* ARotatableActor::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
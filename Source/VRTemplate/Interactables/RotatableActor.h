@@ -347,4 +347,5 @@ public:
 	/**  Get and set functions to allow changes from blueprint. */
 	virtual FHandInterfaceSettings GetInterfaceSettings_Implementation() override;
 	virtual void SetInterfaceSettings_Implementation(FHandInterfaceSettings newInterfaceSettings) override;
+	virtual const FHandInterfaceSettings* GetNativeInterfaceSettings() const override;
 };
@@ -2,6 +2,7 @@
 
 #include "Interactables/RotatableStaticMesh.h"
 #include "Player/VRHand.h"
+#include "Project/AudioVoicePool.h"
 #include "DrawDebugHelpers.h"
 #include "Components/BoxComponent.h"
 #include "Components/SceneComponent.h"
@@ -293,7 +294,7 @@ void URotatableStaticMesh::Lock(float lockingAngle)
 		// If lock haptic effect is enable and not null play on hand then release. Also play sound.
 		if (handRef)
 		{
-			if (lockHapticEffect) handRef->PlayFeedback(lockHapticEffect, 1.0f);
+			if (lockHapticEffect) handRef->PlayFeedback(lockHapticEffect, 1.0f, false, EHapticPriority::High);
 			if (releaseWhenLocked) handRef->ReleaseGrabbedActor();
 		}
 
@@ -319,7 +320,7 @@ void URotatableStaticMesh::Lock(float lockingAngle)
 		if (!grabWhileLocked) interactableSettings.canInteract = false;
 
 		// Play locking sound. Only if there is a locking sound.
-		if (lockSound) UGameplayStatics::PlaySoundAtLocation(GetWorld(), lockSound, GetComponentLocation());
+		if (lockSound) AAudioVoicePool::PlaySoundAtLocation(this, lockSound, GetComponentLocation(), 1.0f, 1.0f, EAudioVoicePriority::High);
 
 		// Log.
 		UE_LOG(LogRotatableMesh, Warning, TEXT("The Rotatable %s was locked at rotation %f."), *GetName(), lockingAngle);
@@ -541,3 +542,8 @@ void URotatableStaticMesh::SetInterfaceSettings_Implementation(FHandInterfaceSet
 	interactableSettings = newInterfaceSettings;
 }
 
+const FHandInterfaceSettings* URotatableStaticMesh::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
+
@@ -10,6 +10,7 @@
 #include "Components/BoxComponent.h"
 #include "Project/SimpleTimeline.h"
 #include "Project/EffectsContainer.h"
+#include "Project/AudioVoicePool.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Player/VRPhysicsHandleComponent.h"
@@ -73,6 +74,8 @@ ASlidableActor::ASlidableActor()
 	centerConstraint = false;
 	hapticIntensity = 1.0f;
 	impactSoundIntensity = 1.5f;
+	velocityWindow = 0.05f;
+	currentVelocity = FVector::ZeroVector;
 
 #if DEVELOPMENT
 	debug = false;
@@ -161,13 +164,14 @@ void ASlidableActor::Tick(float DeltaTime)
 		if (activeAxis > 1) CheckConstraintBounds();
 
 		// Keep track of positional velocity.
-		currentPosition = slidingMesh->GetComponentLocation();
-		currentVelocity = (currentPosition - lastPosition) / DeltaTime;
-		lastPosition = currentPosition;
+		slidingHistory.AddSample(slidingMesh->GetComponentLocation(), slidingMesh->GetComponentQuat(), DeltaTime);
+		currentVelocity = slidingHistory.GetLinearVelocity(velocityWindow);
 
 		// Update audio and haptic effects.
 		UpdateAudioAndHaptics();
 	}
+	// Clear the history once stopped so the next movement doesn't include the time stopped.
+	else if (slidingHistory.Num() > 0) slidingHistory.Reset();
 
 #if DEVELOPMENT
 	ShowConstraintBounds();
@@ -408,7 +412,7 @@ void ASlidableActor::UpdateAudioAndHaptics()
 			// Play audio if set and not playing the impact sound currently.
 			if (impactSound)
 			{
-				UGameplayStatics::PlaySoundAtLocation(GetWorld(), impactSound, slidableAudio->GetComponentLocation(), intensity * impactSoundIntensity);
+				AAudioVoicePool::PlaySoundAtLocation(this, impactSound, slidableAudio->GetComponentLocation(), intensity * impactSoundIntensity);
 				imapctSoundEnabled = false;
 			}
 		}
@@ -530,3 +534,8 @@ void ASlidableActor::SetInterfaceSettings_Implementation(FHandInterfaceSettings
 {
 	interactableSettings = newInterfaceSettings;
 }
+
+const FHandInterfaceSettings* ASlidableActor::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
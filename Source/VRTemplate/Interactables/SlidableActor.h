@@ -5,6 +5,7 @@
 #include "GameFramework/Actor.h"
 #include "Player/HandsInterface.h"
 #include "Project/VRFunctionLibrary.h"
+#include "Project/KinematicHistory.h"
 #include "Globals.h"
 #include "SlidableActor.generated.h"
 
@@ -136,6 +137,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slidable|HapticEffects", meta = (UIMin = "0.1", ClampMin = "0.1"))
 	float hapticIntensity;
 
+	/** Time back from the current frame that the sliding velocity is fitted over for the audio and haptic effects. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slidable|HapticEffects", meta = (ClampMin = "0.0", ClampMax = "0.25"))
+	float velocityWindow;
+
 	/** Debug boolean variable */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Slidable|Constraint")
 	bool debug;
@@ -176,9 +181,9 @@ private:
 
 	FTransform originalTransform;/** Original actor transform saved at begin play. */
 	FVector originalGrabOffset; /** Original grab offset of the hand to the Slidable mesh to prevent jumping when this is grabbed. */
-	FVector currentVelocity; /** velocity while grabbed to be re-applied on release. Also last frames position used to calculate the velocity. */
+	FVector currentVelocity; /** Velocity of the sliding mesh fitted from its kinematic history. */
 	FVector constraintOffset;
-	FVector currentPosition, lastPosition; /** Variables to keep track of the current velocity. */
+	FKinematicHistory slidingHistory; /** Recorded transforms of the sliding mesh while grabbed or moving, used to keep track of the current velocity. */
 	FVector lastHapticFeedbackPosition; /** The last position haptic feedback was performed on. */
 
 	bool limitedToRange; /** Is this interactable limited/constrained to a range. */
@@ -244,4 +249,5 @@ public:
 	/**  Get and set functions to allow changes from blueprint. */
 	virtual FHandInterfaceSettings GetInterfaceSettings_Implementation() override;
 	virtual void SetInterfaceSettings_Implementation(FHandInterfaceSettings newInterfaceSettings) override;
+	virtual const FHandInterfaceSettings* GetNativeInterfaceSettings() const override;
 };
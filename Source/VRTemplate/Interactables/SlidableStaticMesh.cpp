@@ -310,3 +310,8 @@ void USlidableStaticMesh::SetInterfaceSettings_Implementation(FHandInterfaceSett
 {
 	interactableSettings = newInterfaceSettings;
 }
+
+const FHandInterfaceSettings* USlidableStaticMesh::GetNativeInterfaceSettings() const
+{
+	return &interactableSettings;
+}
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/ComfortEffects.h"
+
+FComfortEffects::FComfortEffects()
+{
+	for (FEffect& effect : effects)
+	{
+		effect.value = 0.0f;
+		effect.startValue = 0.0f;
+		effect.target = 0.0f;
+		effect.duration = 0.0f;
+		effect.time = 0.0f;
+		effect.changed = false;
+	}
+	animatingMask = 0;
+	dirty = false;
+}
+
+void FComfortEffects::Start(EComfortEffect effectType, float target, float duration, TFunction<void()> onFinished)
+{
+	FEffect& effect = effects[(int32)effectType];
+	const uint32 bit = 1 << (int32)effectType;
+
+	// Already there or on the way.
+	if (effect.target == target && (IsAnimating(effectType) || effect.value == target))
+	{
+		if (onFinished)
+		{
+			if (IsAnimating(effectType)) effect.onFinished = MoveTemp(onFinished);
+			else onFinished();
+		}
+		return;
+	}
+
+	// Start from the current value so interrupting an animation doesn't jump.
+	effect.startValue = effect.value;
+	effect.target = target;
+	effect.duration = FMath::Max(duration, 0.0f);
+	effect.time = 0.0f;
+	effect.onFinished = MoveTemp(onFinished);
+	animatingMask |= bit;
+}
+
+void FComfortEffects::Set(EComfortEffect effectType, float value)
+{
+	FEffect& effect = effects[(int32)effectType];
+	effect.value = value;
+	effect.startValue = value;
+	effect.target = value;
+	effect.changed = true;
+	effect.onFinished = nullptr;
+	animatingMask &= ~(1 << (int32)effectType);
+	dirty = true;
+}
+
+bool FComfortEffects::Update(float deltaTime)
+{
+	if (animatingMask == 0 && !dirty) return false;
+
+	// Effects that were set count as changed.
+	bool anyChanged = dirty;
+	dirty = false;
+	for (int32 i = 0; i < (int32)EComfortEffect::Count; i++)
+	{
+		const uint32 bit = 1 << i;
+		if ((animatingMask & bit) == 0) continue;
+
+		// Ease in and out between the start and target values.
+		FEffect& effect = effects[i];
+		effect.time += deltaTime;
+		const float alpha = effect.duration > 0.0f ? FMath::Clamp(effect.time / effect.duration, 0.0f, 1.0f) : 1.0f;
+		effect.value = FMath::Lerp(effect.startValue, effect.target, FMath::SmoothStep(0.0f, 1.0f, alpha));
+		effect.changed = true;
+		anyChanged = true;
+
+		// Finished, the callback is moved out first as it may start the effect again.
+		if (alpha >= 1.0f)
+		{
+			effect.value = effect.target;
+			animatingMask &= ~bit;
+			TFunction<void()> onFinished = MoveTemp(effect.onFinished);
+			effect.onFinished = nullptr;
+			if (onFinished) onFinished();
+		}
+	}
+	return anyChanged;
+}
+
+bool FComfortEffects::ConsumeChanged(EComfortEffect effectType)
+{
+	FEffect& effect = effects[(int32)effectType];
+	const bool changed = effect.changed;
+	effect.changed = false;
+	return changed;
+}
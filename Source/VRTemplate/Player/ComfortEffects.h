@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** Comfort effects animated by the comfort effects scheduler. */
+enum class EComfortEffect : uint8
+{
+	Vignette, /** Opacity of the vignette, 1 is invisible. */
+	Fade, /** Amount the camera is faded, 1 is fully faded. */
+	Count,
+};
+
+/** Animates the comfort effects used during movement as eased curves over time, replacing a timer and interpolation per effect. Update is
+ * called once a frame and does nothing unless an effect is animating, the owner then writes each changed effect once.
+ * NOTE: The owner applies the values to the materials and camera. */
+class VRTEMPLATE_API FComfortEffects
+{
+public:
+
+	/** Constructor. */
+	FComfortEffects();
+
+	/** Animate an effect to a target value. Does nothing if already at or animating towards the target.
+	 * @Param effect, The effect to animate.
+	 * @Param target, The value to animate to.
+	 * @Param duration, Time to reach the target, if zero the target is set on the next update.
+	 * @Param onFinished, Called once the target is reached, cleared if the effect is animated to another target before then. */
+	void Start(EComfortEffect effect, float target, float duration, TFunction<void()> onFinished = nullptr);
+
+	/** Set the value of an effect immediately, stopping any animation. Marks the effect as changed. */
+	void Set(EComfortEffect effect, float value);
+
+	/** Advance any animating effects.
+	 * @Param deltaTime, Time since the last update.
+	 * @Return true if any effect changed. */
+	bool Update(float deltaTime);
+
+	/** @Return true and clears the flag if the effect has changed since it was last consumed. */
+	bool ConsumeChanged(EComfortEffect effect);
+
+	/** @Return the current value of an effect. */
+	float GetValue(EComfortEffect effect) const { return effects[(int32)effect].value; }
+
+	/** @Return the value an effect is animating to, or its value if not animating. */
+	float GetTarget(EComfortEffect effect) const { return effects[(int32)effect].target; }
+
+	/** @Return true if the effect is animating. */
+	bool IsAnimating(EComfortEffect effect) const { return (animatingMask & (1 << (int32)effect)) != 0; }
+
+	/** @Return true if any effect is animating. */
+	bool IsAnimating() const { return animatingMask != 0; }
+
+private:
+
+	/** The state of an effect. */
+	struct FEffect
+	{
+		float value; /** Current value. */
+		float startValue; /** Value when the animation started. */
+		float target; /** Value to animate to. */
+		float duration; /** Length of the animation. */
+		float time; /** Time into the animation. */
+		bool changed; /** Has the value changed since last consumed. */
+		TFunction<void()> onFinished; /** Called when the target is reached. */
+	};
+
+	FEffect effects[(int32)EComfortEffect::Count]; /** State of each effect. */
+	uint32 animatingMask; /** Bit for each effect currently animating. */
+	bool dirty; /** Has an effect been set since the last update. */
+};
@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Player/HandsInterface.h"
+#include "Player/HandsInterfaceCache.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/ShapeComponent.h"
 #include "VRHand.h"
@@ -31,7 +32,8 @@ void IHandsInterface::Overlapping_Implementation(AVRHand* hand)
 {
 	// Get the interfaces settings.
 	UObject* objectClass = _getUObject();
-	FHandInterfaceSettings currentSettings = IHandsInterface::Execute_GetInterfaceSettings(objectClass);
+	FHandInterfaceSettings settingsCopy;
+	const FHandInterfaceSettings& currentSettings = IHandsInterface::ReadInterfaceSettings(objectClass, settingsCopy);
 
 	// Add the overlapped hand.
 	overlappingHands.Add(hand);
@@ -89,7 +91,8 @@ void IHandsInterface::EndOverlapping_Implementation(AVRHand* hand)
 {
 	// Get the interfaces settings.
 	UObject* objectClass = _getUObject();
-	FHandInterfaceSettings currentSettings = IHandsInterface::Execute_GetInterfaceSettings(objectClass);
+	FHandInterfaceSettings settingsCopy;
+	const FHandInterfaceSettings& currentSettings = IHandsInterface::ReadInterfaceSettings(objectClass, settingsCopy);
 
 	// Remove the overlapped hand.
 	overlappingHands.Remove(hand);
@@ -159,3 +162,22 @@ void IHandsInterface::SetInterfaceSettings_Implementation(FHandInterfaceSettings
 {
 	UE_LOG(LogHandsInterface, Warning, TEXT("Setting interface settings did not work as SetInterfaceSettings has no override."));
 }
+
+const FHandInterfaceSettings* IHandsInterface::GetNativeInterfaceSettings() const
+{
+	return nullptr;
+}
+
+const FHandInterfaceSettings& IHandsInterface::ReadInterfaceSettings(UObject* object, FHandInterfaceSettings& fallback)
+{
+	// Read the settings directly from C++ implementers that don't have GetInterfaceSettings overridden in BP.
+	IHandsInterface* nativeInterface = Cast<IHandsInterface>(object);
+	if (nativeInterface && FHandsInterfaceCache::Get().UsesNativeSettings(object->GetClass()))
+	{
+		if (const FHandInterfaceSettings* nativeSettings = nativeInterface->GetNativeInterfaceSettings()) return *nativeSettings;
+	}
+
+	// Otherwise fall back to the event.
+	fallback = IHandsInterface::Execute_GetInterfaceSettings(object);
+	return fallback;
+}
@@ -185,4 +185,14 @@ public:
  	/**  Get and set functions to allow changes to an interactable. */
 	virtual FHandInterfaceSettings GetInterfaceSettings_Implementation();
  	virtual void SetInterfaceSettings_Implementation(FHandInterfaceSettings newInterfaceSettings);
+
+	/** Native fast path to the settings, C++ implementers return a pointer to their stored settings so the hands can read them without a copy or going through ProcessEvent.
+	 * NOTE: Returns nullptr by default. Not used for classes that override GetInterfaceSettings in BP, those always go through the event. */
+	virtual const FHandInterfaceSettings* GetNativeInterfaceSettings() const;
+
+	/** Read the settings of an object implementing this interface, using the native fast path when available otherwise calling GetInterfaceSettings.
+	 * @Param object, The object implementing the interface.
+	 * @Param fallback, Storage for the settings if they have to be copied from GetInterfaceSettings.
+	 * @Return The objects settings, only valid while the object and fallback are and should not be held onto. */
+	static const FHandInterfaceSettings& ReadInterfaceSettings(UObject* object, FHandInterfaceSettings& fallback);
 };
@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/HandsInterfaceCache.h"
+#include "Player/HandsInterface.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+
+FHandsInterfaceCache& FHandsInterfaceCache::Get()
+{
+	static FHandsInterfaceCache cache;
+	return cache;
+}
+
+FHandsInterfaceCache::FHandsInterfaceCache()
+{
+	hits = 0;
+	misses = 0;
+
+	// Prune stale entries after each garbage collection.
+	garbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FHandsInterfaceCache::OnPostGarbageCollect);
+}
+
+UObject* FHandsInterfaceCache::Resolve(USceneComponent* comp)
+{
+	if (!comp || !comp->GetOwner()) return nullptr;
+
+	// Use the cached result if the component hasn't been re-attached or re-tagged since.
+	FResolvedInterface& entry = entries.FindOrAdd(comp);
+	if (IsEntryValid(comp, entry))
+	{
+		hits++;
+		return entry.found ? entry.interfaceObject.Get() : nullptr;
+	}
+
+	// Otherwise resolve and store the result.
+	misses++;
+	ResolveUncached(comp, entry);
+	return entry.found ? entry.interfaceObject.Get() : nullptr;
+}
+
+bool FHandsInterfaceCache::ImplementsHandsInterface(const UClass* objectClass)
+{
+	if (!objectClass) return false;
+
+	// Grow the bitsets to fit this class.
+	const int32 classIndex = objectClass->GetUniqueID();
+	if (classIndex >= classChecked.Num())
+	{
+		classChecked.Add(false, classIndex + 1 - classChecked.Num());
+		classImplements.Add(false, classIndex + 1 - classImplements.Num());
+	}
+
+	// Check the class once and store the result.
+	if (!classChecked[classIndex])
+	{
+		classChecked[classIndex] = true;
+		classImplements[classIndex] = objectClass->ImplementsInterface(UHandsInterface::StaticClass());
+	}
+	return classImplements[classIndex];
+}
+
+bool FHandsInterfaceCache::UsesNativeSettings(const UClass* objectClass)
+{
+	if (!objectClass) return false;
+
+	// Grow the bitsets to fit this class.
+	const int32 classIndex = objectClass->GetUniqueID();
+	if (classIndex >= classNativeChecked.Num())
+	{
+		classNativeChecked.Add(false, classIndex + 1 - classNativeChecked.Num());
+		classNativeSettings.Add(false, classIndex + 1 - classNativeSettings.Num());
+	}
+
+	// A BP override of the getter is a non native function, the native version comes from the interface itself.
+	if (!classNativeChecked[classIndex])
+	{
+		UFunction* getter = objectClass->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(IHandsInterface, GetInterfaceSettings));
+		classNativeChecked[classIndex] = true;
+		classNativeSettings[classIndex] = !getter || getter->HasAnyFunctionFlags(FUNC_Native);
+	}
+	return classNativeSettings[classIndex];
+}
+
+void FHandsInterfaceCache::Invalidate(USceneComponent* comp)
+{
+	entries.Remove(comp);
+}
+
+void FHandsInterfaceCache::InvalidateAll()
+{
+	entries.Reset();
+	classChecked.Reset();
+	classImplements.Reset();
+	classNativeChecked.Reset();
+	classNativeSettings.Reset();
+}
+
+void FHandsInterfaceCache::ResolveUncached(USceneComponent* comp, FResolvedInterface& entry)
+{
+	AActor* owner = comp->GetOwner();
+	entry.interfaceObject = nullptr;
+	entry.parents.Reset();
+	entry.componentTagCount = comp->ComponentTags.Num();
+	entry.actorTagCount = owner->Tags.Num();
+	entry.reachedRoot = false;
+	entry.found = false;
+
+	// Check the component for the interface.
+	if (ImplementsHandsInterface(comp->GetClass()))
+	{
+		entry.interfaceObject = comp;
+		entry.found = true;
+		return;
+	}
+
+	// Check components actor for the interface before searching through its parents.
+	bool componentHasTag = comp->ComponentHasTag(FName("Grabbable"));
+	bool actorHasTag = owner->ActorHasTag(FName("Grabbable"));
+	if (ImplementsHandsInterface(owner->GetClass()) && (actorHasTag || componentHasTag))
+	{
+		entry.interfaceObject = owner;
+		entry.found = true;
+		return;
+	}
+
+	// Look through each parent in order from bottom to top, remembering the path taken to validate the result later.
+	USceneComponent* parentComponent = comp->GetAttachParent();
+	while (parentComponent)
+	{
+		entry.parents.Add(parentComponent);
+		if (ImplementsHandsInterface(parentComponent->GetClass()))
+		{
+			entry.interfaceObject = parentComponent;
+			entry.found = true;
+			return;
+		}
+		parentComponent = parentComponent->GetAttachParent();
+	}
+	entry.reachedRoot = true;
+}
+
+bool FHandsInterfaceCache::IsEntryValid(USceneComponent* comp, const FResolvedInterface& entry) const
+{
+	// A new entry or a destroyed interface owner.
+	if (entry.found && !entry.interfaceObject.IsValid()) return false;
+	if (!entry.found && !entry.reachedRoot) return false;
+
+	// Tags have been added or removed.
+	if (entry.componentTagCount != comp->ComponentTags.Num() || entry.actorTagCount != comp->GetOwner()->Tags.Num()) return false;
+
+	// The component or one of the parents walked through has been attached or detached.
+	USceneComponent* parentComponent = comp;
+	for (const TWeakObjectPtr<USceneComponent>& cachedParent : entry.parents)
+	{
+		parentComponent = parentComponent->GetAttachParent();
+		if (parentComponent != cachedParent.Get()) return false;
+	}
+	if (entry.reachedRoot && parentComponent->GetAttachParent()) return false;
+	return true;
+}
+
+void FHandsInterfaceCache::OnPostGarbageCollect()
+{
+	for (auto it = entries.CreateIterator(); it; ++it)
+	{
+		if (!it.Key().IsValid()) it.RemoveCurrent();
+	}
+	entries.Compact();
+	classChecked.Reset();
+	classImplements.Reset();
+	classNativeChecked.Reset();
+	classNativeSettings.Reset();
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+/** Declare classes used. */
+class USceneComponent;
+class UClass;
+
+/** Game thread cache of which object owns the hands interface for a given component, used by AVRHand::LookForInterface.
+ * Each entry remembers the attach parents and tag counts it was resolved with and is re-resolved if any of those change, so attaching,
+ * detaching or tagging interactables at runtime is picked up without needing to walk the hierarchy with reflection queries every frame.
+ * Whether a UClass implements the hands interface, or overrides its settings getter in BP, is stored in bitsets indexed by the classes unique ID.
+ * NOTE: Cleared of stale entries after every garbage collection. */
+class VRTEMPLATE_API FHandsInterfaceCache
+{
+public:
+
+	/** Get the global cache. */
+	static FHandsInterfaceCache& Get();
+
+	/** Find the first interactable interface going from the component up through the parents to the actor.
+	 * @Param comp, Component to look through itself and its parent components for the interface.
+	 * @Return UObject pointer to the game object that owns the interface. */
+	UObject* Resolve(USceneComponent* comp);
+
+	/** @Return true if the given class implements the hands interface. Cached per class. */
+	bool ImplementsHandsInterface(const UClass* objectClass);
+
+	/** @Return true if the given class can use the native settings fast path, false if GetInterfaceSettings is overridden in BP. Cached per class. */
+	bool UsesNativeSettings(const UClass* objectClass);
+
+	/** Force the given component to be re-resolved on its next lookup. Call after modifying tags in place (Not just adding/removing). */
+	void Invalidate(USceneComponent* comp);
+
+	/** Clear the whole cache. */
+	void InvalidateAll();
+
+	/** Stats for debugging how effective the cache is. */
+	uint32 GetHits() const { return hits; }
+	uint32 GetMisses() const { return misses; }
+
+private:
+
+	/** Cached result and the state it was resolved with. */
+	struct FResolvedInterface
+	{
+		TWeakObjectPtr<UObject> interfaceObject; /** The resolved interface owner, invalid if nothing was found. */
+		TArray<TWeakObjectPtr<USceneComponent>, TInlineAllocator<4>> parents; /** Attach parents walked through while resolving. */
+		int32 componentTagCount; /** Number of tags on the component when resolved. */
+		int32 actorTagCount; /** Number of tags on the owning actor when resolved. */
+		bool reachedRoot; /** Resolution walked to the top of the attach hierarchy. */
+		bool found; /** An interface owner was found. */
+
+		FResolvedInterface()
+		{
+			componentTagCount = 0;
+			actorTagCount = 0;
+			reachedRoot = false;
+			found = false;
+		}
+	};
+
+	TMap<TWeakObjectPtr<USceneComponent>, FResolvedInterface> entries; /** Cached resolutions per component. */
+	TBitArray<> classChecked; /** Classes that have been checked for the interface, indexed by unique ID. */
+	TBitArray<> classImplements; /** Classes that implement the interface, indexed by unique ID. */
+	TBitArray<> classNativeChecked; /** Classes that have been checked for a BP override of GetInterfaceSettings, indexed by unique ID. */
+	TBitArray<> classNativeSettings; /** Classes without a BP override of GetInterfaceSettings, indexed by unique ID. */
+	FDelegateHandle garbageCollectHandle; /** Handle to the post garbage collection delegate. */
+	uint32 hits, misses; /** Number of lookups that used or missed the cache. */
+
+private:
+
+	/** Constructor. */
+	FHandsInterfaceCache();
+
+	/** Resolve the interface for the component by searching its hierarchy, filling out the entry. */
+	void ResolveUncached(USceneComponent* comp, FResolvedInterface& entry);
+
+	/** @Return true if the entry still matches the components current hierarchy and tags. */
+	bool IsEntryValid(USceneComponent* comp, const FResolvedInterface& entry) const;
+
+	/** Remove destroyed components and reset the class bits as class unique ID's can be reused after a garbage collection. */
+	void OnPostGarbageCollect();
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/HapticMixer.h"
+
+FHapticMixer::FHapticMixer()
+{
+	hasPending = false;
+}
+
+bool FHapticMixer::Submit(const FHapticRequest& request)
+{
+	stats.requests++;
+
+	// First request of the frame wins by default.
+	if (!hasPending)
+	{
+		pending = request;
+		hasPending = true;
+		return true;
+	}
+
+	// Merge requests for the same effect, keeping the strongest values.
+	if (request.effect == pending.effect)
+	{
+		pending.intensity = FMath::Max(pending.intensity, request.intensity);
+		pending.priority = FMath::Max(pending.priority, request.priority);
+		pending.replace |= request.replace;
+		stats.merged++;
+		return true;
+	}
+
+	// Otherwise pick by priority then intensity, the loser is dropped.
+	bool wins = request.priority > pending.priority || (request.priority == pending.priority && request.intensity > pending.intensity);
+	if (wins) pending = request;
+	stats.dropped++;
+	return wins;
+}
+
+bool FHapticMixer::Consume(FHapticRequest& winner)
+{
+	if (!hasPending) return false;
+	winner = pending;
+	hasPending = false;
+	return true;
+}
+
+bool FHapticMixer::ShouldInterrupt(const FHapticRequest& winner, bool playing, float playingIntensity, EHapticPriority playingPriority)
+{
+	// Nothing to interrupt.
+	if (!playing) return true;
+	// Never interrupt a higher priority effect, always interrupt a lower one.
+	if (winner.priority != playingPriority) return winner.priority > playingPriority;
+	// Same priority, only interrupt when told to replace or with a stronger intensity.
+	return winner.replace || playingIntensity < winner.intensity;
+}
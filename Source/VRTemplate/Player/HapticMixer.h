@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "HapticMixer.generated.h"
+
+/** Declare classes used. */
+class UHapticFeedbackEffect_Base;
+
+/** Priority of a haptic request, higher priorities win the frame over lower ones regardless of intensity. */
+UENUM(BlueprintType)
+enum class EHapticPriority : uint8
+{
+	Low UMETA(DisplayName = "Low", ToolTip = "Continuous background feedback, distance rumble etc."),
+	Normal UMETA(DisplayName = "Normal", ToolTip = "Default feedback, impacts, sliding, rotating etc."),
+	High UMETA(DisplayName = "High", ToolTip = "Important one off feedback, grabbing, pressing, locking etc."),
+};
+
+/** Counters for how many haptic requests the mixer has handled. */
+USTRUCT(BlueprintType)
+struct FHapticMixerStats
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Total requests submitted. */
+	UPROPERTY(BlueprintReadOnly, Category = "Haptics")
+	int requests;
+
+	/** Requests for the same effect in the same frame that were merged into one. */
+	UPROPERTY(BlueprintReadOnly, Category = "Haptics")
+	int merged;
+
+	/** Requests that lost the frame to another effect or couldn't interrupt the playing effect. */
+	UPROPERTY(BlueprintReadOnly, Category = "Haptics")
+	int dropped;
+
+	/** Number of times the controller was actually told to play an effect. */
+	UPROPERTY(BlueprintReadOnly, Category = "Haptics")
+	int deviceCalls;
+
+	/** Default constructor. */
+	FHapticMixerStats()
+	{
+		requests = 0;
+		merged = 0;
+		dropped = 0;
+		deviceCalls = 0;
+	}
+};
+
+/** A single request to play a haptic effect. */
+struct FHapticRequest
+{
+	UHapticFeedbackEffect_Base* effect; /** The effect to play. */
+	float intensity; /** Intensity to play the effect at. */
+	EHapticPriority priority; /** Priority of this request. */
+	bool replace; /** Should this request replace any playing effect. */
+
+	FHapticRequest()
+	{
+		effect = nullptr;
+		intensity = 0.0f;
+		priority = EHapticPriority::Normal;
+		replace = false;
+	}
+
+	FHapticRequest(UHapticFeedbackEffect_Base* newEffect, float newIntensity, EHapticPriority newPriority, bool shouldReplace)
+	{
+		effect = newEffect;
+		intensity = newIntensity;
+		priority = newPriority;
+		replace = shouldReplace;
+	}
+};
+
+/** Collects haptic requests made during a frame and picks a single winner to be sent to the controller.
+ * Requests for the same effect are merged keeping the strongest intensity, different effects are decided by priority then intensity.
+ * NOTE: Owned by each AVRHand and flushed once per frame from AVRPawn::PostUpdateTick. */
+class VRTEMPLATE_API FHapticMixer
+{
+public:
+
+	/** Constructor. */
+	FHapticMixer();
+
+	/** Add a request to the current frame.
+	 * @Param request, The request to mix.
+	 * @Return true if the request is currently winning the frame. */
+	bool Submit(const FHapticRequest& request);
+
+	/** Take the winning request of this frame and reset for the next one.
+	 * @Param winner, Filled with the winning request.
+	 * @Return false if nothing was requested this frame. */
+	bool Consume(FHapticRequest& winner);
+
+	/** Decide if a winning request should interrupt the effect currently playing on the controller.
+	 * @Param winner, The winning request of the frame.
+	 * @Param playing, Is an effect currently playing on the controller.
+	 * @Param playingIntensity, The intensity of the playing effect.
+	 * @Param playingPriority, The priority of the playing effect.
+	 * @Return true if the winner should be played. */
+	static bool ShouldInterrupt(const FHapticRequest& winner, bool playing, float playingIntensity, EHapticPriority playingPriority);
+
+	/** Mark a consumed request as dropped, when it could not interrupt the currently playing effect. */
+	void MarkDropped() { stats.dropped++; }
+
+	/** Mark a device call as made. */
+	void MarkDeviceCall() { stats.deviceCalls++; }
+
+	/** @Return the counters for this mixer. */
+	const FHapticMixerStats& GetStats() const { return stats; }
+
+	/** Reset the counters. */
+	void ResetStats() { stats = FHapticMixerStats(); }
+
+private:
+
+	FHapticRequest pending; /** Current winning request for this frame. */
+	bool hasPending; /** Has anything been requested this frame. */
+	FHapticMixerStats stats; /** Counters. */
+};
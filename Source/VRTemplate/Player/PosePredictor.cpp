@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/PosePredictor.h"
+#include "Project/KinematicHistory.h"
+
+FPosePredictor::FPosePredictor()
+{
+	maxPredictionTime = 0.03f;
+	maxPredictedDistance = 5.0f;
+	maxPredictedAngle = 15.0f;
+	velocityWindow = 0.035f;
+}
+
+bool FPosePredictor::Predict(const FKinematicHistory& history, float predictionTime, FVector& location, FQuat& rotation) const
+{
+	if (history.Num() == 0) return false;
+	const FKinematicSample& newest = history.GetSample(0);
+	location = newest.location;
+	rotation = newest.rotation;
+	if (history.Num() < 2) return false;
+
+	// Clamp the time then the distance and angle of the prediction.
+	const float time = FMath::Clamp(predictionTime, 0.0f, maxPredictionTime);
+	const FVector linearVelocity = history.GetLinearVelocity(velocityWindow).GetClampedToMaxSize(maxPredictedDistance / FMath::Max(time, SMALL_NUMBER));
+	const FVector angularVelocity = history.GetAngularVelocity(velocityWindow).GetClampedToMaxSize(FMath::DegreesToRadians(maxPredictedAngle) / FMath::Max(time, SMALL_NUMBER));
+	Extrapolate(newest.location, newest.rotation, linearVelocity, angularVelocity, time, location, rotation);
+	return true;
+}
+
+void FPosePredictor::Extrapolate(const FVector& location, const FQuat& rotation, const FVector& linearVelocity, const FVector& angularVelocity, float time,
+	FVector& outLocation, FQuat& outRotation)
+{
+	outLocation = location + linearVelocity * time;
+
+	// Rotate around the angular velocity axis by the angle covered in the given time.
+	const float speed = angularVelocity.Size();
+	if (speed > SMALL_NUMBER)
+	{
+		outRotation = FQuat(angularVelocity / speed, speed * time) * rotation;
+		outRotation.Normalize();
+	}
+	else outRotation = rotation;
+}
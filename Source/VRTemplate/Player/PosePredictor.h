@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** Declare classes used. */
+class FKinematicHistory;
+
+/** Predicts where a tracked device will be a short time in the future from its recorded kinematic history, used to hide the latency between
+ * the game thread sampling the controllers and the frame being displayed. Velocities are fitted across a window of samples to reduce tracking
+ * noise and the prediction is clamped so a tracking glitch or teleport can never throw the pose far away. */
+class VRTEMPLATE_API FPosePredictor
+{
+public:
+
+	/** Max time that can be predicted ahead. */
+	float maxPredictionTime;
+
+	/** Max distance the predicted location can be from the last sample. */
+	float maxPredictedDistance;
+
+	/** Max angle in degrees the predicted rotation can be from the last sample. */
+	float maxPredictedAngle;
+
+	/** Time back from the newest sample to fit velocities over. */
+	float velocityWindow;
+
+public:
+
+	/** Constructor. */
+	FPosePredictor();
+
+	/** Predict the pose of the device ahead of the newest sample in its history.
+	 * @Param history, The recorded poses of the device.
+	 * @Param predictionTime, Time ahead of the newest sample to predict.
+	 * @Param location, The predicted location.
+	 * @Param rotation, The predicted rotation.
+	 * @Return false if there are not enough samples, location and rotation are set to the newest sample if there is one. */
+	bool Predict(const FKinematicHistory& history, float predictionTime, FVector& location, FQuat& rotation) const;
+
+	/** Extrapolate a pose by the given velocities.
+	 * @Param location, Start location.
+	 * @Param rotation, Start rotation.
+	 * @Param linearVelocity, Linear velocity in units per second.
+	 * @Param angularVelocity, Angular velocity as an axis scaled by radians per second.
+	 * @Param time, Time to extrapolate over.
+	 * @Param outLocation, The extrapolated location.
+	 * @Param outRotation, The extrapolated rotation. */
+	static void Extrapolate(const FVector& location, const FQuat& rotation, const FVector& linearVelocity, const FVector& angularVelocity, float time,
+		FVector& outLocation, FQuat& outRotation);
+};
@@ -4,6 +4,7 @@
 #include "Player/VRPawn.h"
 #include "Player/HandsAnimInstance.h"
 #include "Player/VRPhysicsHandleComponent.h"
+#include "Player/HandsInterfaceCache.h"
 #include "XRMotionControllerBase.h"
 #include "Haptics/HapticFeedbackEffect_Base.h"
 #include "TimerManager.h"
@@ -26,6 +27,8 @@
 #include "DrawDebugHelpers.h"
 #include "Project/VRFunctionLibrary.h"
 #include "Project/EffectsContainer.h"
+#include "Project/GrabCandidateIndex.h"
+#include "Project/CollisionClearanceService.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include <Sound/SoundBase.h>
 #include "WidgetInteractionComponent.h"
@@ -33,6 +36,11 @@
 
 DEFINE_LOG_CATEGORY(LogHand);
 
+/** Stats for the hand class. */
+DECLARE_STATS_GROUP(TEXT("VRHand"), STATGROUP_VRHand, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Physics Collider Shape Updates"), STAT_HandColliderShapeUpdates, STATGROUP_VRHand);
+DECLARE_CYCLE_STAT(TEXT("Hand Compute Update"), STAT_HandComputeUpdate, STATGROUP_VRHand);
+
 AVRHand::AVRHand()
 {
 	// Tick for this function is ran in the pawn class.
@@ -42,18 +50,21 @@ AVRHand::AVRHand()
 	controller = CreateDefaultSubobject<UMotionControllerComponent>("Controller");
 	controller->MotionSource = FXRMotionControllerBase::LeftHandSourceId;
 	controller->SetupAttachment(scene);
-	controller->bDisableLowLatencyUpdate = true;
 	RootComponent = controller;
 
 	// handRoot comp.
 	handRoot = CreateDefaultSubobject<USceneComponent>(TEXT("HandRoot"));
 	handRoot->SetupAttachment(controller);
 
+	// Predicted root comp, offset by the predicted controller pose while the colliders stay on the handRoot.
+	predictedRoot = CreateDefaultSubobject<USceneComponent>(TEXT("PredictedRoot"));
+	predictedRoot->SetupAttachment(handRoot);
+
 	// Skeletal mesh component for the hand model. Default setup.
 	handSkel = CreateDefaultSubobject<USkeletalMeshComponent>("handSkel");
 	handSkel->SetCollisionProfileName("Hand");
 	handSkel->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	handSkel->SetupAttachment(handRoot);
+	handSkel->SetupAttachment(predictedRoot);
 	handSkel->SetRenderCustomDepth(true);
 	handSkel->SetGenerateOverlapEvents(true);
 	handSkel->SetCustomDepthStencilValue(1); // Custom stencil mask material for showing hands through objects.
@@ -119,13 +130,26 @@ AVRHand::AVRHand()
 	hideOnGrab = true;	
 	active = true;
 	handIsLocked = false;
+	useGrabCandidateIndex = true;
+	velocityWindow = 0.05f;
+	throwWindow = 0.1f;
+	lateUpdate = true;
+	predictionTime = 0.0f;
+	predictionApplied = false;
 	collisionEnabled = false;
 	thumbstick = FVector2D(0.0f, 0.0f);
 	distanceFrameCount = 0;
+	currentHapticIntesity = 0.0f;
+	currentHapticPriority = EHapticPriority::Normal;
 
 	// PhysicsCollider extent and position values for closed hand state.
 	pcClosedExtent = FVector(6.0f, 3.4f, 5.0f);
 	pcClosedPositiion = FVector(-12.0f, 1.5f, -0.8f);
+	pcMorphSteps = 6;
+	pcMorphState = 0;
+	pcShapeUpdates = 0;
+	pcShapeUpdatesPerSecond = 0;
+	pcShapeUpdateTimer = 0.0f;
 	
 #if WITH_EDITOR
 	debug = false;
@@ -140,10 +164,16 @@ void AVRHand::BeginPlay()
 	// Save the original offset and extent of the physics box Collider for when the hand is open.
 	pcOriginalOffset = physicsCollider->RelativeLocation;
 	pcOpenExtent = physicsCollider->GetUnscaledBoxExtent();
+	BuildColliderMorphStates();
 
-	// Create a joint between the hand skel and the Collider itself so it tracks towards the hand with a max pushing force.
+	// Late update the controller and its children on the render thread if enabled.
+	controller->bDisableLowLatencyUpdate = !lateUpdate;
+	handRootOffset = handRoot->GetRelativeTransform();
+
+	// Create a joint between the hand root and the Collider itself so it tracks towards the hand with a max pushing force.
+	// NOTE: Follows the handRoot and not the handSkel so pose prediction, which only offsets the predictedRoot, never moves the collider.
 	FName handRootBoneName = handSkel->GetBoneName(0);
-	physicsHandle->CreateJointAndFollowLocationWithRotation(physicsCollider, handSkel, NAME_None, physicsCollider->GetComponentLocation(),
+	physicsHandle->CreateJointAndFollowLocationWithRotation(physicsCollider, handRoot, NAME_None, physicsCollider->GetComponentLocation(),
 		physicsCollider->GetComponentRotation());
 
 	// Setup widget interaction attachments.
@@ -173,6 +203,9 @@ void AVRHand::SetupHand(AVRHand * oppositeHand, AVRPawn* playerRef, bool dev)
 
 	// Set up the controller offsets for the current type of controller selected.
 	if (!devModeEnabled) SetupControllerOffset();
+
+	// Get the worlds grab candidate index to find interactables with.
+	if (useGrabCandidateIndex) grabCandidateIndex = AGrabCandidateIndex::Get(GetWorld());
 }
 
 void AVRHand::SetControllerType(EVRController type)
@@ -197,29 +230,105 @@ void AVRHand::SetupControllerOffset()
 		handRoot->AddLocalOffset(FVector(7.5f, 0.0f, 0.0f));
 	break;
 	}
+
+	// Save the offset to apply any pose prediction on top of, removing any prediction currently applied to the predictedRoot.
+	handRootOffset = handRoot->GetRelativeTransform();
+	if (predictionApplied) predictedRoot->SetRelativeTransform(FTransform::Identity);
+	predictionApplied = false;
 }
 
 void AVRHand::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Calculate controller velocity as its not simulating physics.
-	lastHandPosition = currentHandPosition;
-	currentHandPosition = controller->GetComponentLocation();
-	handVelocity = (currentHandPosition - lastHandPosition) / DeltaTime;
-	
-	// Calculate angular velocity for the controller for when its not simulating physics.
-	lastHandRotation = currentHandRotation;
-	currentHandRotation = controller->GetComponentQuat();
-	FQuat deltaRot = lastHandRotation.Inverse() * currentHandRotation;
-	FVector axis;
-	float angle;
-	deltaRot.ToAxisAndAngle(axis, angle);
-	angle = FMath::RadiansToDegrees(angle);
-	handAngularVelocity = currentHandRotation.RotateVector((axis * angle) / DeltaTime);
+	// Gather the controller state, compute the update from it and apply it back to the hand.
+	GatherUpdateInput(DeltaTime);
+	ComputeUpdate();
+	ApplyUpdate(DeltaTime);
+}
+
+void AVRHand::GatherUpdateInput(float deltaTime)
+{
+	// Controller velocities are calculated from its recorded transforms as its not simulating physics.
+	updateInput.position = controller->GetComponentLocation();
+	updateInput.rotation = controller->GetComponentQuat();
+	updateInput.deltaTime = deltaTime;
+	updateInput.velocityWindow = velocityWindow;
+	updateInput.trigger = trigger;
+	updateInput.predictionTime = predictionTime;
+	updateInput.gripping = gripping;
+	updateInput.morphStepCount = pcMorphExtents.Num();
+}
+
+void AVRHand::ComputeUpdate()
+{
+	SCOPE_CYCLE_COUNTER(STAT_HandComputeUpdate);
+
+	// Record this frames controller transform.
+	handHistory.AddSample(updateInput.position, updateInput.rotation, updateInput.deltaTime);
+	ComputeHandUpdate(updateInput, handHistory, updateOutput);
+
+	// Predict the controller pose ahead and store it relative to the current pose.
+	updateOutput.predicting = false;
+	if (updateInput.predictionTime > 0.0f)
+	{
+		FVector predictedLocation;
+		FQuat predictedRotation;
+		if (posePredictor.Predict(handHistory, updateInput.predictionTime, predictedLocation, predictedRotation))
+		{
+			updateOutput.predictedDelta = FTransform(predictedRotation, predictedLocation).GetRelativeTransform(FTransform(updateInput.rotation, updateInput.position));
+			updateOutput.predicting = true;
+		}
+	}
+}
+
+void AVRHand::ComputeHandUpdate(const FHandUpdateInput& input, const FKinematicHistory& history, FHandUpdateOutput& output)
+{
+	// Fit the controllers linear and angular velocity over the window. Angular velocity is in degrees.
+	output.velocity = history.GetLinearVelocity(input.velocityWindow);
+	output.angularVelocity = FMath::RadiansToDegrees(history.GetAngularVelocity(input.velocityWindow));
+
+	// Animation inputs for the handSkel.
+	output.pointing = input.gripping;
+	output.fingerClosingAmount = 1.0f - input.trigger;
+	output.handClosingAmount = input.trigger * 100.0f;
+
+	// Snap the trigger to the nearest physics collider morph step.
+	output.morphState = input.morphStepCount > 0 ? FMath::RoundToInt(FMath::Clamp(input.trigger, 0.0f, 1.0f) * (input.morphStepCount - 1)) : 0;
+}
+
+FVector AVRHand::GetThrowVelocity() const
+{
+	return handHistory.GetPeakLinearVelocity(throwWindow);
+}
+
+FTransform AVRHand::GetPredictedTransform(const USceneComponent* comp) const
+{
+	if (!predictionApplied) return comp->GetComponentTransform();
+	return comp->GetComponentTransform().GetRelativeTransform(handRoot->GetComponentTransform()) * predictedRoot->GetComponentTransform();
+}
+
+void AVRHand::ApplyUpdate(float deltaTime)
+{
+	// Update the hands velocity.
+	handVelocity = updateOutput.velocity;
+	handAngularVelocity = updateOutput.angularVelocity;
+
+	// Offset the hand mesh and anything held by AttatchTo to the predicted controller pose, or remove the offset when no longer predicting.
+	// NOTE: Only the predictedRoot is moved, the handRoot and the physics and grab colliders attached to it stay on the tracked pose.
+	if (updateOutput.predicting)
+	{
+		predictedRoot->SetRelativeTransform(handRootOffset * updateOutput.predictedDelta * handRootOffset.Inverse());
+		predictionApplied = true;
+	}
+	else if (predictionApplied)
+	{
+		predictedRoot->SetRelativeTransform(FTransform::Identity);
+		predictionApplied = false;
+	}
 
 	// Keep the physical Collider tracked to the hand correctly.
-	UpdatePhysicalCollision(DeltaTime);
+	UpdatePhysicalCollision(deltaTime);
 
 	// Update the animation instance variables for the handSkel.
 	UpdateAnimationInstance();
@@ -228,7 +337,7 @@ void AVRHand::Tick(float DeltaTime)
 	if (objectInHand)
 	{
 		// Execute dragging for the grabbed object.
-		IHandsInterface::Execute_Dragging(objectInHand, DeltaTime);
+		IHandsInterface::Execute_Dragging(objectInHand, deltaTime);
 
 		// Update interactable distance for releasing over max distance.
 		CheckInteractablesDistance();
@@ -272,7 +381,8 @@ void AVRHand::Grab()
 		// Release the actor from the other hand if it has the objectToGrab grabbed and the grabbed object does NOT support two handed grabbing.
 		if (otherHand && objectToGrab == otherHand->objectInHand)
 		{
-			FHandInterfaceSettings otherGrabbedObjectSettings = IHandsInterface::Execute_GetInterfaceSettings(otherHand->objectInHand);
+			FHandInterfaceSettings settingsCopy;
+			const FHandInterfaceSettings& otherGrabbedObjectSettings = IHandsInterface::ReadInterfaceSettings(otherHand->objectInHand, settingsCopy);
 			if (!otherGrabbedObjectSettings.twoHandedGrabbing) otherHand->ReleaseGrabbedActor();
 		}
 
@@ -286,7 +396,7 @@ void AVRHand::Grab()
 		IHandsInterface::Execute_EndOverlapping(objectInHand, this);
 
 		// Feedback to indicate the object has been grabbed.
-		PlayFeedback(); 
+		PlayFeedback(nullptr, 1.0f, false, EHapticPriority::High);
 	}
 }
 
@@ -314,9 +424,10 @@ void AVRHand::Drop()
 	if (objectInHand)
 	{
 		// Get the objects interface settings.
-		FHandInterfaceSettings grabbedObjectSettings = IHandsInterface::Execute_GetInterfaceSettings(objectInHand);
+		FHandInterfaceSettings settingsCopy;
+		const bool lockedToHand = IHandsInterface::ReadInterfaceSettings(objectInHand, settingsCopy).lockedToHand;
 		// Release the object if it is not locked to the hand.
-		if (!grabbedObjectSettings.lockedToHand) ReleaseGrabbedActor();
+		if (!lockedToHand) ReleaseGrabbedActor();
 		// Otherwise 
 		else
 		{
@@ -377,8 +488,8 @@ void AVRHand::Grip(bool pressed)
 	// Release the grabbed interactable if the hand is locked and the grip button is released.
 	if (objectInHand)
 	{	
-		FHandInterfaceSettings grabbedObjectSettings = IHandsInterface::Execute_GetInterfaceSettings(objectInHand);
-		if (grabbedObjectSettings.lockedToHand && !pressed)
+		FHandInterfaceSettings settingsCopy;
+		if (!pressed && IHandsInterface::ReadInterfaceSettings(objectInHand, settingsCopy).lockedToHand)
 		{
 			ReleaseGrabbedActor();
 			grabbing = false;
@@ -390,6 +501,9 @@ void AVRHand::TeleportHand()
 {
 	// Used on components that need re-positioning after a teleportation.
 	if (objectInHand) IHandsInterface::Execute_Teleported(objectInHand);
+
+	// Don't see the teleport as movement.
+	handHistory.Reset();
 }
 
 void AVRHand::UpdateControllerTrackedState()
@@ -420,6 +534,7 @@ void AVRHand::UpdateControllerTrackedState()
 	{
 		ActivateCollision(false);
 		foundController = false;
+		handHistory.Reset();
 #if WITH_EDITOR
 		if (debug) UE_LOG(LogHand, Warning, TEXT("Lost the controller tracking owned by %s"), *GetName());
 #endif
@@ -428,15 +543,20 @@ void AVRHand::UpdateControllerTrackedState()
 
 void AVRHand::CheckForOverlappingActors()
 {
-	// Get grabColliders current overlapping components.
-	TArray<UPrimitiveComponent*> overlapping;
-	grabCollider->GetOverlappingComponents(overlapping);
 	UObject* toGrab = nullptr;
-	float smallestDistance = 100000.0f;
 
-	// If components are found.
-	if (overlapping.Num() > 0)
+	// Find the closest interactable from the grab candidate index if its in use.
+	if (useGrabCandidateIndex && grabCandidateIndex.IsValid())
 	{
+		toGrab = grabCandidateIndex->FindClosestCandidate(grabCollider);
+	}
+	// Otherwise get grabColliders current overlapping components.
+	else
+	{
+		TArray<UPrimitiveComponent*> overlapping;
+		grabCollider->GetOverlappingComponents(overlapping);
+		float smallestDistance = 100000.0f;
+
 		// Loop through each overlapping component and find the closest one with an interface.
 		for (UPrimitiveComponent* comp : overlapping)
 		{
@@ -445,8 +565,8 @@ void AVRHand::CheckForOverlappingActors()
 			if (objectWithInterface)
 			{
 				// Make sure this interface is currently allowing interaction.
-				FHandInterfaceSettings objectsInterfaceSettings = IHandsInterface::Execute_GetInterfaceSettings(objectWithInterface);
-				if (!objectsInterfaceSettings.canInteract)
+				FHandInterfaceSettings settingsCopy;
+				if (!IHandsInterface::ReadInterfaceSettings(objectWithInterface, settingsCopy).canInteract)
 				{
 					// End overlapping before exiting this function.
 					if (objectToGrab)
@@ -491,47 +611,45 @@ void AVRHand::CheckForOverlappingActors()
 UObject* AVRHand::LookForInterface(USceneComponent* comp)
 {
 	// Check the component for the interface then work way up each parent until one is found. If not return null.
-	bool componentHasTag = comp->ComponentHasTag("Grabbable");
-	bool componentHasInterface = comp->GetClass()->ImplementsInterface(UHandsInterface::StaticClass());
-	if (componentHasInterface) return comp;
-	else
+	// NOTE: Results are cached per component and only re-resolved when its hierarchy or tags change.
+	return FHandsInterfaceCache::Get().Resolve(comp);
+}
+
+void AVRHand::BuildColliderMorphStates()
+{
+	// Step 0 is the open extent and the last step is the closed extent.
+	int steps = FMath::Max(pcMorphSteps, 1);
+	pcMorphExtents.SetNum(steps + 1);
+	for (int i = 0; i <= steps; i++)
 	{
-		// Check components actor for the interface before searching through its parents.
-		bool actorHasTag = comp->GetOwner()->ActorHasTag(FName("Grabbable"));
-		bool actorHasInterface = comp->GetOwner()->GetClass()->ImplementsInterface(UHandsInterface::StaticClass());
-		if (actorHasInterface && (actorHasTag || componentHasTag)) return comp->GetOwner();
-		// If the components actor doest have the interface and has a parent component look for interface here.
-		else if (comp->GetAttachParent())
-		{
-			// Look through each parent in order from bottom to top, then if nothing is found check the actor itself.
-			bool searching = true;
-			USceneComponent* parentComponent = comp->GetAttachParent();
-			while (searching)
-			{
-				bool parentHasInterface = parentComponent->GetClass()->ImplementsInterface(UHandsInterface::StaticClass());
-				// If the parent has the interface and is grabbable use this component.
-				if (parentHasInterface)
-				{
-					return parentComponent;
-					searching = false;
-				}
-				else if (parentComponent->GetAttachParent()) parentComponent = parentComponent->GetAttachParent();
-				// If there are no more attach parents exit the while loop.
-				else searching = false;
-			}
-		}
+		pcMorphExtents[i] = FMath::Lerp(pcOpenExtent, pcClosedExtent, (float)i / (float)steps);
 	}
-	return nullptr;
-}
 
+	// The collider starts at its open extent.
+	pcMorphState = 0;
+}
 
 void AVRHand::UpdatePhysicalCollision(float deltaTime)
 {
-	// Update the boxes extent and positioning for when the hand is closed or opened.
-	FVector controllerClosedOffset = (pcOriginalOffset - pcClosedPositiion) * -trigger;
-	FVector lerpingExt = FMath::Lerp(pcOpenExtent, pcClosedExtent, trigger);
-	physicsCollider->SetBoxExtent(lerpingExt);
-	FVector newControllerLocation = controller->GetComponentTransform().TransformPosition(controllerClosedOffset);
+	// Only update the box extent when the morph step from the compute phase changes.
+	// NOTE: Overlaps are not updated here as the collider is moved by the physics handle which will update them.
+	int32 newMorphState = updateOutput.morphState;
+	if (newMorphState != pcMorphState && pcMorphExtents.IsValidIndex(newMorphState))
+	{
+		physicsCollider->SetBoxExtent(pcMorphExtents[newMorphState], false);
+		pcMorphState = newMorphState;
+		pcShapeUpdates++;
+		INC_DWORD_STAT(STAT_HandColliderShapeUpdates);
+	}
+
+	// Count the shape updates per second.
+	pcShapeUpdateTimer += deltaTime;
+	if (pcShapeUpdateTimer >= 1.0f)
+	{
+		pcShapeUpdatesPerSecond = FMath::RoundToInt(pcShapeUpdates / pcShapeUpdateTimer);
+		pcShapeUpdates = 0;
+		pcShapeUpdateTimer = 0.0f;
+	}
 
 	// Check if the current location is too far away from the hand. If it is teleport the physicsCollider into position.
 	float distanceToController = (controller->GetComponentTransform().TransformPositionNoScale(pcOriginalOffset) - physicsCollider->GetComponentLocation()).Size();
@@ -552,7 +670,8 @@ void AVRHand::CheckInteractablesDistance()
 	if (objectInHand)
 	{
 		// Get the grabbed objects interface settings.
-		FHandInterfaceSettings grabbedObjectSettings = IHandsInterface::Execute_GetInterfaceSettings(objectInHand);
+		FHandInterfaceSettings settingsCopy;
+		const FHandInterfaceSettings& grabbedObjectSettings = IHandsInterface::ReadInterfaceSettings(objectInHand, settingsCopy);
 
 		// Get required variables from the current grabbed objects interface.
 		float currentHandGrabDistance = grabbedObjectSettings.handDistance;
@@ -574,7 +693,7 @@ void AVRHand::CheckInteractablesDistance()
 			return;
 		}
 		// Otherwise Rumble the hand with the intensity relative to the distance between the hand an grabbed actor. Use default feedback effect.
-		else if (currentHandGrabDistance > currentHandMinRumbleDist && currentCanRelease) PlayFeedback(nullptr, (currentHandGrabDistance - currentHandMinRumbleDist) / 20, true);
+		else if (currentHandGrabDistance > currentHandMinRumbleDist && currentCanRelease) PlayFeedback(nullptr, (currentHandGrabDistance - currentHandMinRumbleDist) / 20, true, EHapticPriority::Low);
 		else return;
 	}
 }
@@ -585,9 +704,9 @@ void AVRHand::UpdateAnimationInstance()
 	UHandsAnimInstance* handAnim = Cast<UHandsAnimInstance>(handSkel->GetAnimInstance());	
 	if (handAnim)
 	{
-		handAnim->pointing = gripping;
-		handAnim->fingerClosingAmount = (1 - trigger);
-		handAnim->handClosingAmount = trigger * 100.0f;
+		handAnim->pointing = updateOutput.pointing;
+		handAnim->fingerClosingAmount = updateOutput.fingerClosingAmount;
+		handAnim->handClosingAmount = updateOutput.handClosingAmount;
 	}
 }
 
@@ -602,12 +721,15 @@ void AVRHand::ActivateCollision(bool open, float openDelay)
 {
 	if (handSkel)
 	{
+		ACollisionClearanceService* clearanceService = ACollisionClearanceService::Get(GetWorld());
 		if (open)// When the hand is open allow all collision to be enabled after a delay while interactables fall out of the way.
 		{
 			handSkel->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-			FTimerDelegate timerDel;
-			timerDel.BindUFunction(this, FName("CollisionDelay"));
-			GetWorldTimerManager().SetTimer(colTimerHandle, timerDel, 0.1f, true, openDelay);
+			if (clearanceService)
+			{
+				clearanceService->CancelWait(physicsCollider);
+				clearanceService->WaitUntilClear(handSkel, ECC_Hand, player->actorsToIgnore, FOnCollisionClear::CreateUObject(this, &AVRHand::HandSkelClear), openDelay);
+			}
 			collisionEnabled = true;
 		}
 		else// Disable collision while the hand is closed to prevent accidental interactions.
@@ -616,7 +738,11 @@ void AVRHand::ActivateCollision(bool open, float openDelay)
 			physicsCollider->SetCollisionProfileName("PhysicsActorOff");
 			physicsCollider->SetNotifyRigidBodyCollision(false);
 			collisionEnabled = false;
-			GetWorldTimerManager().ClearTimer(colTimerHandle);
+			if (clearanceService)
+			{
+				clearanceService->CancelWait(handSkel);
+				clearanceService->CancelWait(physicsCollider);
+			}
 		}
 
 #if WITH_EDITOR
@@ -626,53 +752,56 @@ void AVRHand::ActivateCollision(bool open, float openDelay)
 	}
 }
 
-void AVRHand::CollisionDelay()
+void AVRHand::HandSkelClear()
 {
-	// Only re-enable the collision if the handSkel is no longer overlapping anything.
-	TArray<UPrimitiveComponent*> overlappingComps;
-	bool overlapping = UVRFunctionLibrary::ComponentOverlapComponentsByChannel(handSkel, handSkel->GetComponentTransform(), ECC_Hand, player->actorsToIgnore, overlappingComps, true);
-
-	// If no longer overlapping any blocking collision to the hand.
-	if (!overlapping)
+	// Also ensure physics collider is no longer overlapping before re-enabling.
+	if (ACollisionClearanceService* clearanceService = ACollisionClearanceService::Get(GetWorld()))
 	{
-		// Also ensure physics collider is no longer overlapping.
-		bool physicsOverlapping = UVRFunctionLibrary::ComponentOverlapComponentsByChannel(physicsCollider, physicsCollider->GetComponentTransform(), ECC_PhysicsBody, player->actorsToIgnore, overlappingComps, true);
-		if (!physicsOverlapping)
-		{
-			// Re-enable collision in this classes colliding components.
-			handSkel->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-			physicsCollider->SetCollisionProfileName("PhysicsActorOn");
-			physicsCollider->SetNotifyRigidBodyCollision(true);
-
-			// End this function loop.
-			GetWorld()->GetTimerManager().ClearTimer(colTimerHandle);
-		}	
+		clearanceService->WaitUntilClear(physicsCollider, ECC_PhysicsBody, player->actorsToIgnore, FOnCollisionClear::CreateUObject(this, &AVRHand::PhysicsColliderClear));
 	}
 }
 
+void AVRHand::PhysicsColliderClear()
+{
+	// Re-enable collision in this classes colliding components.
+	handSkel->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	physicsCollider->SetCollisionProfileName("PhysicsActorOn");
+	physicsCollider->SetNotifyRigidBodyCollision(true);
+}
+
 bool AVRHand::PlaySound(USoundBase* sound, float volume, float pitch, bool replace)
 {
-	// Ensure the audio component is initialized.
-	if (handAudio)
+	// Get the sound to play either from passed reference or the default sound.
+	USoundBase* soundToPlay = sound ? sound : (GetEffects() ? GetEffects()->GetAudioEffect("DefaultCollision") : nullptr);
+
+	// Play through the voice pool, following the hand while playing.
+	if (AAudioVoicePool* voicePool = AAudioVoicePool::Get(GetWorld()))
+	{
+		// If replace is true replace the audio otherwise if playing do not play the sound.
+		bool playing = voicePool->IsPlaying(handVoice);
+		bool shouldPlay = replace ? true : !playing;
+		if (shouldPlay && soundToPlay)
+		{
+			if (playing) voicePool->Stop(handVoice);
+			handVoice = voicePool->PlaySound(soundToPlay, grabCollider->GetComponentLocation(), volume, pitch, EAudioVoicePriority::Normal, grabCollider);
+			return handVoice.IsValid();
+		}
+		else return false;
+	}
+	// Otherwise use the hands own audio component.
+	else if (handAudio)
 	{
 		// If replace is true replace the audio otherwise if playing do not play the sound.
 		bool playing = handAudio->IsPlaying();
 		bool shouldPlay = replace ? true : !playing;
-		if (shouldPlay)
+		if (shouldPlay && soundToPlay)
 		{
-			// Get the sound to play either from passed reference or the default sound.
-			USoundBase* soundToPlay = sound ? sound : GetEffects()->GetAudioEffect("DefaultCollision");		
-			// Play sound if not nullptr.
-			if (soundToPlay)
-			{
-				if (playing) handAudio->Stop();
-				handAudio->SetVolumeMultiplier(volume);
-				handAudio->SetPitchMultiplier(pitch);
-				handAudio->SetSound(soundToPlay);
-				handAudio->Play();
-				return true;
-			}
-			else return false;
+			if (playing) handAudio->Stop();
+			handAudio->SetVolumeMultiplier(volume);
+			handAudio->SetPitchMultiplier(pitch);
+			handAudio->SetSound(soundToPlay);
+			handAudio->Play();
+			return true;
 		}
 		else return false;
 	}
@@ -685,42 +814,59 @@ bool AVRHand::PlaySound(USoundBase* sound, float volume, float pitch, bool repla
 
 void AVRHand::StopSound(bool fade, float timeToFade)
 {
+	// Stop the sound in the voice pool if it was played from there.
+	if (AAudioVoicePool* voicePool = AAudioVoicePool::Get(GetWorld()))
+	{
+		voicePool->Stop(handVoice, fade ? timeToFade : 0.0f);
+	}
+
 	if (fade) handAudio->FadeOut(timeToFade, 0.0f);
 	else handAudio->Stop();
 }
 
-bool AVRHand::PlayFeedback(UHapticFeedbackEffect_Base* feedback, float intensity, bool replace)
+bool AVRHand::PlayFeedback(UHapticFeedbackEffect_Base* feedback, float intensity, bool replace, EHapticPriority priority)
+{
+	// If feedback is null use default haptic feedback otherwise use the feedback pointer passed into this function.
+	UHapticFeedbackEffect_Base* feedbackToUse = feedback;
+	if (!feedbackToUse && GetEffects()) feedbackToUse = GetEffects()->GetFeedbackEffect("Default");
+	if (!feedbackToUse) return false;
+
+	// Add to this frames feedback, the winner is played in FlushFeedback.
+	return hapticMixer.Submit(FHapticRequest(feedbackToUse, intensity, priority, replace));
+}
+
+void AVRHand::FlushFeedback()
 {
+	// Get the winning feedback requested this frame, if any.
+	FHapticRequest winner;
+	RETURN(!hapticMixer.Consume(winner));
+
 	if (owningController)
 	{
-		// Check if should replace feedback effect. If don't replace, still playing and the new intensity is weaker don't play haptic effect.
-		bool shouldPlay = replace ? true : (IsPlayingFeedback() ? GetCurrentFeedbackIntensity() < intensity : true);
-
-		// If should play then play the given feedback haptic effect on this hand classes controller.
-		if (shouldPlay)
+		// Check if the winner should replace any haptic effect currently playing, if not it is dropped.
+		if (!FHapticMixer::ShouldInterrupt(winner, IsPlayingFeedback(), currentHapticIntesity, currentHapticPriority))
 		{
-			// If feedback is null use default haptic feedback otherwise use the feedback pointer passed into this function.
-			UHapticFeedbackEffect_Base* feedbackToUse = feedback;
-			if (!feedbackToUse) feedbackToUse = GetEffects()->GetFeedbackEffect("Default");
-
-			// Play the given haptic effect if not nullptr.
-			if (feedbackToUse)
-			{
-				currentHapticIntesity = intensity;
-				owningController->PlayHapticEffect(feedbackToUse, handEnum, intensity * player->hapticIntensity, false);
-				return true;
-			}
-			else return false;
+			hapticMixer.MarkDropped();
+			return;
 		}
-		else return false;
-	}	
+
+		// Play the winning haptic effect on this hand classes controller.
+		currentHapticIntesity = winner.intensity;
+		currentHapticPriority = winner.priority;
+		owningController->PlayHapticEffect(winner.effect, handEnum, winner.intensity * player->hapticIntensity, false);
+		hapticMixer.MarkDeviceCall();
+	}
 	else
 	{
-	    UE_LOG(LogHand, Log, TEXT("PlayFeedback: The feedback could not be played as the refference to the owning controller has been lost in the hand class %s."), *GetName());
-		return false;
+	    UE_LOG(LogHand, Log, TEXT("FlushFeedback: The feedback could not be played as the refference to the owning controller has been lost in the hand class %s."), *GetName());
 	}
 }
 
+FHapticMixerStats AVRHand::GetFeedbackStats() const
+{
+	return hapticMixer.GetStats();
+}
+
 UEffectsContainer* AVRHand::GetEffects()
 {
 	if (player && player->IsValidLowLevel()) return player->GetPawnEffects();
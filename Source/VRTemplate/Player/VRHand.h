@@ -5,6 +5,10 @@
 #include "MotionControllerComponent.h"
 #include "GameFramework/Actor.h"
 #include "Player/HandsInterface.h"
+#include "Player/HapticMixer.h"
+#include "Player/PosePredictor.h"
+#include "Project/KinematicHistory.h"
+#include "Project/AudioVoicePool.h"
 #include "Globals.h"
 #include "VRHand.generated.h"
 
@@ -26,6 +30,7 @@ class UEffectsContainer;
 class UWidgetInteractionComponent;
 class USphereComponent;
 class UWidgetComponent;
+class AGrabCandidateIndex;
 
 /** Controller type enum for selecting the offset of each hand. */
 UENUM(BlueprintType)
@@ -36,6 +41,53 @@ enum class EVRController : uint8
 	Oculus
 };
 
+/** Snapshot of a hands state taken on the game thread, the input to the hands compute phase. */
+struct FHandUpdateInput
+{
+	FVector position; /** Current controller location. */
+	FQuat rotation; /** Current controller rotation. */
+	float deltaTime; /** Frame delta time. */
+	float velocityWindow; /** Time to fit the velocities over. */
+	float trigger; /** Current trigger value. */
+	float predictionTime; /** Time ahead to predict the controller pose, 0 disables prediction. */
+	bool gripping; /** Is the hand gripping. */
+	int32 morphStepCount; /** Number of precomputed physics collider extents. */
+
+	FHandUpdateInput()
+	{
+		position = FVector::ZeroVector;
+		rotation = FQuat::Identity;
+		deltaTime = 0.0f;
+		velocityWindow = 0.0f;
+		trigger = 0.0f;
+		predictionTime = 0.0f;
+		gripping = false;
+		morphStepCount = 0;
+	}
+};
+
+/** Result of a hands compute phase, applied back to the hand on the game thread. */
+struct FHandUpdateOutput
+{
+	FVector velocity, angularVelocity; /** Controller linear and angular velocity. */
+	float fingerClosingAmount, handClosingAmount; /** Hand animation inputs. */
+	FTransform predictedDelta; /** Predicted controller pose relative to the current controller pose. */
+	bool pointing; /** Hand animation pointing input. */
+	bool predicting; /** The predicted delta is valid and should be applied. */
+	int32 morphState; /** Physics collider extent index for the current trigger value. */
+
+	FHandUpdateOutput()
+	{
+		velocity = angularVelocity = FVector::ZeroVector;
+		fingerClosingAmount = 1.0f;
+		handClosingAmount = 0.0f;
+		predictedDelta = FTransform::Identity;
+		pointing = false;
+		predicting = false;
+		morphState = 0;
+	}
+};
+
 /** NOTE: Just flipping a mesh on an axis to create a left and right hand from the said mesh will break its physics asset in version UE4.23
  * NOTE: HandSkel collision used for interacting with grabbable etc. Constrained components must use physicsCollider to prevent constraint breakage. */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
@@ -57,6 +109,10 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
 	USceneComponent* handRoot;
 
+	/** Scene component offset by the predicted controller pose, holds the hand skel and grabbables held with AttatchTo. */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	USceneComponent* predictedRoot;
+
 	/** Pointer to the hand skeletal mesh component from the player controller pawn. Set in BP. */
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite)
 	USkeletalMeshComponent* handSkel;
@@ -127,6 +183,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand")
 	FVector pcClosedPositiion;
 
+	/** Number of steps the physics Collider morphs through between open and closed. The trigger is snapped to the nearest step so the
+	 * collision shape is only updated when the step changes instead of every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand", meta = (ClampMin = "1", ClampMax = "32"))
+	int pcMorphSteps;
+
 	/** Do the hands disappear when grabbing things? */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand")
 	bool hideOnGrab;
@@ -155,6 +216,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Hand|CurrentValues")
 	FVector2D thumbstick;
 	
+	/** How many times the physics Collider shape was updated over the last second. */
+	UPROPERTY(BlueprintReadOnly, Category = "Hand|CurrentValues")
+	int pcShapeUpdatesPerSecond;
+
 	/** Is the hand active. */
 	UPROPERTY(BlueprintReadOnly, Category = "Hand|CurrentValues")
 	bool active;
@@ -172,6 +237,29 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Hand")
 	bool handIsLocked; 
 
+	/** Time back from the current frame that handVelocity and handAngularVelocity are fitted over. Longer is smoother but responds slower. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand", meta = (ClampMin = "0.0", ClampMax = "0.25"))
+	float velocityWindow;
+
+	/** Time back from the current frame to find the peak velocity in for throwing. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand", meta = (ClampMin = "0.0", ClampMax = "0.25"))
+	float throwWindow;
+
+	/** Re-sample the controller pose on the render thread just before rendering and move the hand and anything attached to it to match.
+	 * NOTE: Only the rendered transforms are updated so the physics colliders are unaffected. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand")
+	bool lateUpdate;
+
+	/** Time ahead to predict the controller pose and offset the hand mesh and grabbables held with AttatchTo by, 0 to disable. Use to cover any
+	 * latency left after the late update, or the frame of latency when the late update is disabled.
+	 * NOTE: Only the predictedRoot is offset, the physics and grab colliders stay on the tracked pose. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand", meta = (ClampMin = "0.0", ClampMax = "0.03"))
+	float predictionTime;
+
+	/** Find interactables to grab using the worlds grab candidate index instead of scanning the grab colliders overlaps every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand")
+	bool useGrabCandidateIndex;
+
 protected:
 
 	/** Level start. */
@@ -180,24 +268,43 @@ protected:
 private:
 
 	APlayerController* owningController; /** The owning player controller of this hand class. */
-	FVector lastHandPosition, currentHandPosition;/** Last and current hand positions used for calculating force/velocity etc. */
-	FQuat lastHandRotation, currentHandRotation;
+	TWeakObjectPtr<AGrabCandidateIndex> grabCandidateIndex; /** The worlds grab candidate index, used when useGrabCandidateIndex is enabled. */
+	FKinematicHistory handHistory; /** Recorded controller transforms used for calculating velocity etc. */
 	FTransform originalHandTransform;/** Saved original hand transform at the end of initialization. */	
+	FTransform handRootOffset; /** The handRoot relative transform from the controller offset before any prediction. */
+	FPosePredictor posePredictor; /** Predicts the controller pose from its last few tracked poses. */
+	bool predictionApplied; /** The predictedRoot is currently offset by a predicted pose. */
 	FVector pcOriginalOffset; /** Physics collider original open offset. */
 	FVector pcOpenExtent; /** Physics collider original open extent. */
-	FTimerHandle colTimerHandle, controllerColTimerHandle; /** Timer handle to store a reference to the Collider timer that loops the function CollisionDelay to check for overlapping collision. */
+	TArray<FVector> pcMorphExtents; /** Precomputed physics collider extents for each morph step from open to closed. */
+	int32 pcMorphState; /** Index of the morph step currently applied to the physics collider. */
+	int pcShapeUpdates; /** Physics collider shape updates since the last per second count. */
+	float pcShapeUpdateTimer; /** Time since the last per second count. */
 
+	FHandUpdateInput updateInput; /** State gathered on the game thread for this frames compute phase. */
+	FHandUpdateOutput updateOutput; /** Result of this frames compute phase to be applied in tick. */
 	int distanceFrameCount; /** How many frames has the hand been too far away from the grabbed object. */
 	float currentHapticIntesity; /** The current playing haptic effects intensity for this hand classes controller. */
+	EHapticPriority currentHapticPriority; /** The current playing haptic effects priority for this hand classes controller. */
+	FHapticMixer hapticMixer; /** Mixes all feedback requested during a frame into a single call to the controller. */
+	FAudioVoiceHandle handVoice; /** Handle to the last sound played from this hand through the worlds voice pool. */
 	bool collisionEnabled; /** Collision is enabled or disabled for this hand, disabled on begin play until the controller is tracked. */
 	bool lastFrameOverlap; /** Did we overlap something in the last frame. */
 	bool devModeEnabled; /** Local bool to check if dev mode is enabled. */
 
 private:
 
-	/** Loops every 0.1 seconds checking if the handSkel component is currently overlapping physics etc. If not re-enable collision, until then loop and check. */
-	UFUNCTION(Category = "Collision")
-	void CollisionDelay();
+	/** Called by the collision clearance service once the handSkel is no longer overlapping physics etc. Then waits for the physicsCollider to be clear. */
+	void HandSkelClear();
+
+	/** Called by the collision clearance service once the physicsCollider is no longer overlapping physics. Re-enables the hands collision. */
+	void PhysicsColliderClear();
+
+	/** Precompute the physics collider extent for each morph step. */
+	void BuildColliderMorphStates();
+
+	/** Apply the result of the compute phase to the hand, its components and any grabbed interactable. Game thread only. */
+	void ApplyUpdate(float deltaTime);
 
 	/** Checks distance to collision to determine weather to temporarily disable it or teleport it back to the hand if blocked behind object. */
 	void UpdatePhysicalCollision(float deltaTime);
@@ -205,11 +312,6 @@ private:
 	/** Check for overlapping actors with the grab Collider. (Runs Overlapping begin and end in hands interface on any actors with said interface) */
 	void CheckForOverlappingActors();
 
-	/** Function to find the first intractable interface going from the component up through the parents to the actor.
-	 * @Param comp, Component to look through itself and its children components for the interface.
-	 * @Return UObject pointer to the game object that owns the interface. */
-	UObject* LookForInterface(USceneComponent* comp);
-
 	/** When the distance between the hand and the grabbed component becomes too great it is released from the hand. */
 	void CheckInteractablesDistance();
 
@@ -221,9 +323,33 @@ public:
 	/** Constructor */
 	AVRHand();
 
-	/** Frame */
+	/** Frame. Gathers, computes and applies the hands update, called from the pawn. */
 	virtual void Tick(float DeltaTime) override;
 
+	/** Snapshot the controller and input state for this frames compute phase. Game thread only.
+	 * @Param deltaTime, Frame delta time. */
+	void GatherUpdateInput(float deltaTime);
+
+	/** Run the compute phase for this hand from the gathered input. Only reads and writes the update structures and the hands history. */
+	void ComputeUpdate();
+
+	/** Compute velocities, animation inputs and the physics collider morph state for a hand. Has no side effects.
+	 * @Param input, The state gathered from the hand.
+	 * @Param history, The hands recorded controller transforms including this frames.
+	 * @Param output, The values to apply back to the hand. */
+	static void ComputeHandUpdate(const FHandUpdateInput& input, const FKinematicHistory& history, FHandUpdateOutput& output);
+
+	/** @Return the recorded controller transforms of this hand. */
+	const FKinematicHistory& GetKinematicHistory() const { return handHistory; }
+
+	/** @Return the world transform of a component under the handRoot moved by the current pose prediction, for targeting grabbables held with AttatchTo.
+	 * @Param comp, The component to get the predicted transform of. (Usually the grabCollider) */
+	FTransform GetPredictedTransform(const USceneComponent* comp) const;
+
+	/** @Return the fastest velocity of the hand within the throwWindow, for releasing thrown interactables. */
+	UFUNCTION(BlueprintCallable, Category = "Hands")
+	FVector GetThrowVelocity() const;
+
 	/** Widget interactor begin overlap event. */
 	UFUNCTION(Category = "Collision")
 	void WidgetInteractorOverlapBegin(class UPrimitiveComponent* OverlappedComp, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -243,6 +369,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hand")
 	void SetupControllerOffset();
 
+	/** Function to find the first intractable interface going from the component up through the parents to the actor.
+	 * @Param comp, Component to look through itself and its children components for the interface.
+	 * @Return UObject pointer to the game object that owns the interface. */
+	static UObject* LookForInterface(USceneComponent* comp);
+
 	/** Update the tracked state and collisions of this controller. */
 	void UpdateControllerTrackedState();
 
@@ -280,7 +411,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hands")
 	void ResetHandle(UVRPhysicsHandleComponent* handleToReset);
 
-	/** Play an audio/Sound base from the current handAudio component at the hands location.
+	/** Play an audio/Sound base through the worlds voice pool at the hands location. Falls back to the handAudio component if there is no pool.
 	 * @Param sound, The sound to play at the current controller location. 
 	 * @Param volume, The volume to play the sound at. 
 	 * @Param pitch, The pitch to play the sound at.
@@ -291,7 +422,7 @@ public:
 	bool PlaySound(USoundBase* sound = nullptr, float volume = 1.0f, float pitch = 1.0f, bool replace = false);
 
 
-	/** Function to stop the current sound playing through the handAudio audio component.
+	/** Function to stop the current sound played from this hand.
 	 * @Param fade, fade the sound out or stop completely. 
 	 * @Param fadeTime, Time to fade the sound out. */
 	UFUNCTION(BlueprintCallable, Category = "Hands")
@@ -301,9 +432,19 @@ public:
 	 * @Param feedback, the feedback effect to use, if left null this function will use the defaultFeedback in the pawn class.
 	 * @Param intensity, the intensity of the effect to play.
 	 * @Param replace, Should replace the current haptic effect playing? If there is one... 
-	 * @NOTE  If replace is false it will only replace a haptic feedback effect if the new intensity is greater than the current playing one. */
+	 * @Param priority, Priority of this feedback against other feedback requested in the same frame or already playing.
+	 * @Return true if the feedback is currently the one that will be played this frame.
+	 * @NOTE  If replace is false it will only replace a haptic feedback effect if the new intensity is greater than the current playing one.
+	 * @NOTE  Requests are mixed and sent to the controller once per frame in FlushFeedback. */
+	UFUNCTION(BlueprintCallable, Category = "Hands")
+	bool PlayFeedback(UHapticFeedbackEffect_Base* feedback = nullptr, float intensity = 1.0f, bool replace = false, EHapticPriority priority = EHapticPriority::Normal);
+
+	/** Send the winning feedback requested this frame to the controller. Called once per frame from the pawn class. */
+	void FlushFeedback();
+
+	/** @Return the counters of requested, merged, dropped and played haptic feedback for this hand. */
 	UFUNCTION(BlueprintCallable, Category = "Hands")
-	bool PlayFeedback(UHapticFeedbackEffect_Base* feedback = nullptr, float intensity = 1.0f, bool replace = false);
+	FHapticMixerStats GetFeedbackStats() const;
 
 	/** Returns the effects container from the pawn class. */
 	UFUNCTION(BlueprintCallable, Category = "Hands")
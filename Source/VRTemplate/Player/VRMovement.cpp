@@ -17,6 +17,9 @@
 #include "Components/SphereComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Project/VRFunctionLibrary.h"
+#include "Project/AudioVoicePool.h"
+#include "Project/NavProjectionCache.h"
+#include "Project/TeleportHeightField.h"
 #include "GameFramework/Actor.h"
 #include "TimerManager.h"
 #include "Components/PrimitiveComponent.h"
@@ -24,8 +27,15 @@
 #include "PhysicsEngine/PhysicsHandleComponent.h"
 #include "DrawDebugHelpers.h"
 #include "NavigationQueryFilter.h"
+#include "NavMesh/RecastNavMesh.h"
+#if WITH_RECAST
+#include "NavMesh/PImplRecastNavMesh.h"
+#endif
+#include "ProceduralMeshComponent.h"
 
 DEFINE_LOG_CATEGORY(LogVRMovement);
+DECLARE_STATS_GROUP(TEXT("VRMovement"), STATGROUP_VRMovement, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Teleport Arc Traces"), STAT_TeleportArcTraces, STATGROUP_VRMovement);
 
 AVRMovement::AVRMovement()
 {
@@ -62,6 +72,13 @@ AVRMovement::AVRMovement()
 	teleportSplineEndMesh->SetWorldScale3D(FVector(0.03f, 0.03f, 0.03f));
 	teleportSplineEndMesh->SetupAttachment(scene);
 
+	teleportArcMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("TeleportArcMesh"));
+	teleportArcMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	teleportArcMesh->SetVisibility(false);
+	teleportArcMesh->SetupAttachment(scene);
+	// Arc vertices are built in world space.
+	teleportArcMesh->SetAbsolute(true, true, true);
+
 	// Setup default values.
 	invalidTeleportColor = FLinearColor::Red;
 	validTeleportColor = FLinearColor::Green;
@@ -77,13 +94,42 @@ AVRMovement::AVRMovement()
 	teleportDistance = 1000.0f;
 	teleportGravity = -1600.0f;
 	teleportSearchDistance = 80.0f;
+	maxSplineSegments = 32;
+	teleportArcMode = EVRTeleportArcMode::SplineMeshes;
+	teleportArcRings = 24;
+	teleportArcSides = 6;
+	teleportArcRadius = 1.0f;
+	teleportArcFrequency = 30.0f;
+	teleportArcMaxTime = 2.0f;
+	teleportArcFineSteps = 8;
+	teleportArcReuseDistance = 0.5f;
+	teleportArcReuseAngle = 0.25f;
+	teleportArcRefreshTime = 0.25f;
+	lastArcTraced = false;
+	lastFloorOffset = 0.0f;
+	asyncTeleportQueries = false;
+	useTeleportHeightField = true;
+	fixedStepLocomotion = false;
+	locomotionBackend = EVRLocomotionBackend::Physics;
+	navWalkingSearchDistance = 50.0f;
+	locomotionStepRate = 120.0f;
+	maxLocomotionSubsteps = 8;
+	locomotionInput = FVector::ZeroVector;
+	groundProbeDistance = 1.0f;
+	groundProbeLocation = FVector::ZeroVector;
+	groundProbed = false;
+	lastArcEndTime = 0.0f;
+	lastArcTraceTime = 0.0f;
+	arcMeshCreated = false;
+	activeSplineMeshes = 0;
+	lastMaterialValid = -1;
 	currentMovementMode = EVRMovementMode::Teleport;
 	currentDirectionMode = EVRDirectionMode::Camera;
 	teleportableTypes.Add(EObjectTypeQuery::ObjectTypeQuery9);
 	cameraMoveDirection = true;
 	vignetteDuringMovement = true;
 	canApplyVignette = true;
-	lastVignetteOpacity = 1.0f;
+	comfortEffects.Set(EComfortEffect::Vignette, 1.0f);
 	minVignetteSpeed = 0.2f;
 	vignetteTransitionSpeed = 5.0f;
 	devHandOffset = FVector(70.0f, 25.0f, 8.0f);
@@ -103,6 +149,9 @@ AVRMovement::AVRMovement()
 
 void AVRMovement::Tick(float DeltaTime)
 {
+	// Animate the vignette and camera fade.
+	UpdateComfortEffects(DeltaTime);
+
 	//  Check if the capsule is currently in the air and if it is enable physics, otherwise disable physics.
 	if (player)
 	{
@@ -118,14 +167,11 @@ void AVRMovement::Tick(float DeltaTime)
 		case EVRMovementMode::Joystick:
 		case EVRMovementMode::SwingingArms:
 		{
-			FHitResult floorCheck;
-			FCollisionQueryParams floorTraceParams;
-			floorTraceParams.AddIgnoredActor(this);
-			floorTraceParams.AddIgnoredActor(player);
-			FVector feetLocation = player->scene->GetComponentLocation();
-			GetWorld()->LineTraceSingleByProfile(floorCheck, feetLocation, feetLocation - FVector(0.0f, 0.0f, 1.0f), "PlayerCapsule", floorTraceParams);
+			// The nav-mesh keeps the player on the ground when walking on it.
+			if (UsingNavMeshLocomotion()) break;
+
 			// If the floor was not found enable physics.
-			if (floorCheck.bBlockingHit)
+			if (UpdateGroundProbe().onGround)
 			{
 				if (player->movementCapsule->IsSimulatingPhysics()) EnableCapsule(false);
 			}
@@ -133,9 +179,103 @@ void AVRMovement::Tick(float DeltaTime)
 		}
 		break;
 		}
+
+		// Step the continuous movement modes at a fixed rate.
+		if (fixedStepLocomotion && currentMovementMode != EVRMovementMode::Teleport && currentMovementMode != EVRMovementMode::Developer) UpdateLocomotion(DeltaTime);
 	}
 }
 
+void AVRMovement::UpdateLocomotion(float deltaTime)
+{
+	// Step the movement simulation with this frames input, then consume it.
+	FVector movement = locomotion.Advance(deltaTime, locomotionInput);
+	locomotionInput = FVector::ZeroVector;
+	movement.Z = 0.0f;
+	if (movement.IsNearlyZero()) return;
+
+	// Walk along the nav-mesh if enabled, stopping if the player isn't on it.
+	if (UsingNavMeshLocomotion())
+	{
+		if (!MoveOnNavMesh(movement)) locomotion.Reset();
+		return;
+	}
+
+	// Apply all of this frames movement in a single sweep, sliding along anything hit.
+	FHitResult hit;
+	UFloatingPawnMovement* pawnMovement = player->floatingMovement;
+	pawnMovement->SafeMoveUpdatedComponent(movement, pawnMovement->UpdatedComponent->GetComponentQuat(), true, hit);
+	if (hit.IsValidBlockingHit())
+	{
+		locomotion.ClipVelocity(hit.Normal);
+		pawnMovement->SlideAlongSurface(movement, 1.0f - hit.Time, hit.Normal, hit, true);
+	}
+}
+
+bool AVRMovement::MoveOnNavMesh(const FVector& movement)
+{
+#if WITH_RECAST
+	// Find the nav-mesh for the players agent once.
+	if (!walkingNavMesh.IsValid())
+	{
+		UNavigationSystemV1* navSystem = Cast<UNavigationSystemV1>(GetWorld()->GetNavigationSystem());
+		if (navSystem) walkingNavMesh = Cast<ARecastNavMesh>(navSystem->GetNavDataForProps(player->floatingMovement->GetNavAgentPropertiesRef()));
+		if (!walkingNavMesh.IsValid()) return false;
+	}
+	ARecastNavMesh* navMesh = walkingNavMesh.Get();
+	if (!navWalker.Init(navMesh->GetRecastMesh())) return false;
+	const FRecastQueryFilter* filter = static_cast<const FRecastQueryFilter*>(navMesh->GetDefaultQueryFilterImpl());
+	if (!filter) return false;
+
+	// Place the walker under the players body when they start walking, or again where it was if its polygon was rebuilt so it is never placed across an edge.
+	FVector bodyLocation = player->camera->GetComponentLocation();
+	bodyLocation.Z = player->scene->GetComponentLocation().Z;
+	if (!navWalker.IsPlaced())
+	{
+		const FVector walkingExtent = FVector(navWalkingSearchDistance, navWalkingSearchDistance, navWalkingSearchDistance);
+		if (!navWalker.Place(navWalker.HasLocation() ? navWalker.GetLocation() : bodyLocation, walkingExtent, filter)) return false;
+	}
+
+	// Follow the players body as they walk around the room from the polygon they were last on, so it is clamped at the edges instead of placed across them.
+	if (!navWalker.Move(bodyLocation, filter)) return false;
+
+	// Move along the nav-mesh and move the player by the same amount, including any change in height of the nav-mesh.
+	const FVector startLocation = navWalker.GetLocation();
+	if (!navWalker.Move(startLocation + movement, filter)) return false;
+	const FVector navMovement = navWalker.GetLocation() - startLocation;
+	player->AddActorWorldOffset(navMovement, false, nullptr, ETeleportType::TeleportPhysics);
+
+	// Stop velocity into the edge if the move was cut short.
+	const FVector lostMovement = movement - FVector(navMovement.X, navMovement.Y, 0.0f);
+	if (!lostMovement.IsNearlyZero()) locomotion.ClipVelocity(-lostMovement.GetSafeNormal());
+	return true;
+#else
+	return false;
+#endif
+}
+
+const FVRGroundData& AVRMovement::UpdateGroundProbe(bool force)
+{
+	// Only trace again if the feet or the floor have moved, or the player is in the air.
+	const FVector feetLocation = player->scene->GetComponentLocation();
+	UPrimitiveComponent* floor = groundData.floor.Get();
+	bool moved = force || !groundProbed || !groundData.onGround || !floor;
+	moved = moved || FVector::DistSquared(feetLocation, groundProbeLocation) > FMath::Square(groundProbeDistance);
+	moved = moved || !floor->GetComponentTransform().Equals(groundFloorTransform, 0.01f);
+	if (!moved) return groundData;
+
+	// Trace down from the feet.
+	FHitResult floorCheck;
+	GetWorld()->LineTraceSingleByProfile(floorCheck, feetLocation, feetLocation - FVector(0.0f, 0.0f, 1.0f), "PlayerCapsule", groundProbeParams);
+	groundData.onGround = floorCheck.bBlockingHit;
+	groundData.location = floorCheck.bBlockingHit ? floorCheck.Location : feetLocation;
+	groundData.normal = floorCheck.bBlockingHit ? floorCheck.ImpactNormal : FVector::UpVector;
+	groundData.floor = floorCheck.GetComponent();
+	if (groundData.floor.IsValid()) groundFloorTransform = groundData.floor->GetComponentTransform();
+	groundProbeLocation = feetLocation;
+	groundProbed = true;
+	return groundData;
+}
+
 void AVRMovement::SetupMovement(AVRPawn* playerPawn, bool dev)
 {
 	// Get and store a reference to the players controller.
@@ -184,6 +324,18 @@ void AVRMovement::SetupMovement(AVRPawn* playerPawn, bool dev)
 		// Initialise teleport width as the ring mesh width. Box extent is half the size of the box that fits the component.
 		teleportWidth = teleportRing->Bounds.BoxExtent.X;
 
+		// Create the spline meshes for the teleport arc up front so aiming never creates or destroys components.
+		if (teleportArcMode == EVRTeleportArcMode::SplineMeshes) CreateSplineMeshPool();
+		// Otherwise setup the arc mesh, the section is recreated in case the ring or side counts have changed.
+		else
+		{
+			arcBuilder.numRings = teleportArcRings;
+			arcBuilder.numSides = teleportArcSides;
+			arcBuilder.radius = teleportArcRadius;
+			arcBuilder.BuildTriangles(arcMeshData);
+			arcMeshCreated = false;
+		}
+
 		// Disable capsule collision if in teleport mode.
 		player->movementCapsule->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	}
@@ -196,13 +348,33 @@ void AVRMovement::SetupMovement(AVRPawn* playerPawn, bool dev)
 	// Still call speed ramp, joystick and swinging arms code as its still needed so no break.
 	case EVRMovementMode::SpeedRamp: case EVRMovementMode::Joystick:  case EVRMovementMode::SwingingArms:
 	{
-		// Setup the capsule.
-		player->movementCapsule->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+		// Setup the capsule, when walking on the nav-mesh it is never swept so only needs query collision.
+		player->movementCapsule->SetCollisionEnabled(UsingNavMeshLocomotion() ? ECollisionEnabled::QueryOnly : ECollisionEnabled::QueryAndPhysics);
 		player->movementCapsule->SetCollisionProfileName("PlayerCapsule");
+		walkingNavMesh = nullptr;
+#if WITH_RECAST
+		navWalker.Reset();
+#endif
 
 		// Set speed of floating movement component.
 		player->floatingMovement->MaxSpeed = walkingSpeed;
 
+		// Setup the fixed step locomotion with the same speeds as the floating movement component. Tick after the pawn so its input is used the same frame.
+		locomotion.fixedStep = 1.0f / FMath::Max(locomotionStepRate, 1.0f);
+		locomotion.maxSubsteps = maxLocomotionSubsteps;
+		locomotion.maxSpeed = walkingSpeed;
+		locomotion.acceleration = player->floatingMovement->Acceleration;
+		locomotion.deceleration = player->floatingMovement->Deceleration;
+		locomotion.Reset();
+		locomotionInput = FVector::ZeroVector;
+		AddTickPrerequisiteActor(player);
+
+		// Setup the ground probe params once and probe again next tick.
+		groundProbeParams = FCollisionQueryParams(SCENE_QUERY_STAT(GroundProbe), false);
+		groundProbeParams.AddIgnoredActor(this);
+		groundProbeParams.AddIgnoredActor(player);
+		groundProbed = false;
+
 		// Setup material for vignette so the opacity can be adjusted.
 		if (vignetteDuringMovement)
 		{
@@ -211,7 +383,7 @@ void AVRMovement::SetupMovement(AVRPawn* playerPawn, bool dev)
 				player->vignette->SetActive(true);
 				player->vignette->SetVisibility(true);
 				vignetteMAT = player->vignette->CreateDynamicMaterialInstance(0, vingetteMATInstance);
-				vignetteMAT->SetScalarParameterValue("opacity", 1.0f);
+				comfortEffects.Set(EComfortEffect::Vignette, 1.0f);
 			}
 			else UE_LOG(LogVRMovement, Warning, TEXT("Null refference for the vignette material instance in the vr movement class..."));
 		}
@@ -297,7 +469,7 @@ void AVRMovement::UpdateMovement(AVRHand* movementHand, bool released)
 			case EVRMovementMode::SwingingArms:
 			{
 				// Update the controller movement mode. If released and vignette is enabled ramp the opacity back down to invisible at the specified speed.
-				if (released && vignetteDuringMovement && vignetteMAT) GetWorld()->GetTimerManager().SetTimer(vignetteTimer, this, &AVRMovement::ResetVignette, 0.01f, true);
+				if (released && vignetteDuringMovement && vignetteMAT) ResetVignette();
 				else UpdateControllerMovement(movementHand);
 			}
 			break;
@@ -501,13 +673,7 @@ void AVRMovement::UpdateDeveloperMovement(float deltaTime)
 void AVRMovement::UpdateControllerMovement(AVRHand* movementHand)
 {
 	// Lerp opacity to visible. visible opacity = 0.0f
-	if (vignetteDuringMovement && canApplyVignette && vignetteMAT && lastVignetteOpacity > 0.0f)
-	{
-		// stop vignette reset function is playing on the world timer.
-		GetWorld()->GetTimerManager().ClearTimer(vignetteTimer);
-		// Lerp to location.
-		LerpVignette(0.0f);
-	}
+	if (vignetteDuringMovement && canApplyVignette && vignetteMAT) LerpVignette(0.0f);
 
 	// Update the capsule if the player is not inside of it.
 	FVector capsuleOffset = player->movementCapsule->GetComponentLocation() - player->camera->GetComponentLocation();
@@ -515,7 +681,7 @@ void AVRMovement::UpdateControllerMovement(AVRHand* movementHand)
 	float maxOffsetSizeBeforeReset = player->movementCapsule->GetUnscaledCapsuleRadius();
 
 	// If the capsule is not close enough to the player reset its position and reposition the player inside.
-	if (capsuleOffset.Size() > maxOffsetSizeBeforeReset && currentMovementMode != EVRMovementMode::Lean)
+	if (capsuleOffset.Size() > maxOffsetSizeBeforeReset && currentMovementMode != EVRMovementMode::Lean && !UsingNavMeshLocomotion())
 	{
 		// NOTE: Could add some sort of validation here for checking the nav-mesh for closest available point.
 		// Move capsule to current player location.
@@ -589,7 +755,7 @@ void AVRMovement::UpdateControllerMovement(AVRHand* movementHand)
 		{
 			if (vignetteDuringMovement && canApplyVignette)
 			{
-				if (vignetteMAT) GetWorld()->GetTimerManager().SetTimer(vignetteTimer, this, &AVRMovement::ResetVignette, 0.01f, true);
+				if (vignetteMAT) ResetVignette();
 				canApplyVignette = false;
 			}
 			speedScale = 0.0f;
@@ -627,7 +793,7 @@ void AVRMovement::UpdateControllerMovement(AVRHand* movementHand)
 		if (speedScale > minVignetteSpeed) canApplyVignette = true;
 		else if (canApplyVignette)
 		{
-			GetWorld()->GetTimerManager().SetTimer(vignetteTimer, this, &AVRMovement::ResetVignette, 0.01f, true);
+			ResetVignette();
 			canApplyVignette = false;
 		}
 	}
@@ -635,33 +801,46 @@ void AVRMovement::UpdateControllerMovement(AVRHand* movementHand)
 	// Don't allow any z direction.
 	controllerDirectionNoZ.Z = 0;
 
-	// Apply player movement.
-	player->AddMovementInput(controllerDirectionNoZ, (speedScale / 2) * (walkingSpeed / 100.0f));
+	// Apply player movement, either as input to the fixed step locomotion applied in tick or to the pawns movement component.
+	const float inputScale = (speedScale / 2) * (walkingSpeed / 100.0f);
+	if (fixedStepLocomotion) locomotionInput += controllerDirectionNoZ * inputScale;
+	else player->AddMovementInput(controllerDirectionNoZ, inputScale);
 }
 
 void AVRMovement::ResetVignette()
 {
-	// End the reset once the opacity has been reset.
-	if (lastVignetteOpacity < 1.0f) LerpVignette(1.0f);
-	else GetWorld()->GetTimerManager().ClearTimer(vignetteTimer);
+	// Animate the opacity back to invisible.
+	LerpVignette(1.0f);
 }
 
 void AVRMovement::LerpVignette(float target)
 {
-	float newOpacity = UKismetMathLibrary::FInterpTo(lastVignetteOpacity, target, GetWorld()->GetDeltaSeconds(), vignetteTransitionSpeed);
-	lastVignetteOpacity = newOpacity;
-	vignetteMAT->SetScalarParameterValue("opacity", newOpacity);
+	// Does nothing if already animating to the target so can be called every frame.
+	comfortEffects.Start(EComfortEffect::Vignette, target, 3.0f / FMath::Max(vignetteTransitionSpeed, KINDA_SMALL_NUMBER));
 }
 
-void AVRMovement::UpdateTeleport(AVRHand* movementHand)
+void AVRMovement::UpdateComfortEffects(float deltaTime)
 {
-	// Get rid of last frames spline and initially hide the teleport meshes.
-	DestroyTeleportSpline();
+	// Nothing to do unless an effect is animating or has been set.
+	if (!comfortEffects.Update(deltaTime)) return;
 
-	// Create the teleport spline.
+	// Write each changed effect once.
+	if (comfortEffects.ConsumeChanged(EComfortEffect::Vignette) && vignetteMAT) vignetteMAT->SetScalarParameterValue("opacity", comfortEffects.GetValue(EComfortEffect::Vignette));
+	if (comfortEffects.ConsumeChanged(EComfortEffect::Fade) && playerController && playerController->PlayerCameraManager)
+	{
+		const float fade = comfortEffects.GetValue(EComfortEffect::Fade);
+		if (fade > 0.0f) playerController->PlayerCameraManager->SetManualCameraFade(fade, teleportFadeColor, false);
+		else playerController->PlayerCameraManager->StopCameraFade();
+	}
+}
+
+void AVRMovement::UpdateTeleport(AVRHand* movementHand)
+{
+	// Reshape the teleport spline meshes from the pool.
 	FVector splineEndLocation;
 	FTransform splineStartTrasform = movementHand->movementTarget->GetComponentTransform();
 	bool validLocation = CreateTeleportSpline(splineStartTrasform, splineEndLocation);
+	if (!validLocation) lastTeleportValid = false;
 
 	if (validLocation)
 	{
@@ -699,6 +878,9 @@ void AVRMovement::UpdateTeleport(AVRHand* movementHand)
 		// Otherwise update the teleport material to invalid and disable lastTeleportValid.
 		else UpdateTeleportMaterials(false);
 	}
+
+	// Only hide the ring when there is no valid location so its visibility isn't toggled every frame.
+	if (!lastTeleportValid) teleportRing->SetVisibility(false, true);
 }
 
 bool AVRMovement::CreateTeleportSpline(FTransform startTransform, FVector& outLocation)
@@ -713,14 +895,20 @@ bool AVRMovement::CreateTeleportSpline(FTransform startTransform, FVector& outLo
 		FVector startPoint = startTransform.GetLocation();
 		FVector endPoint = startPoint + (startTransform.GetRotation().GetForwardVector() * 30.0f);
 
-		// Make spline mesh to go from start point to end point.
-		FName splineMeshName = MakeUniqueObjectName(this, USplineMeshComponent::StaticClass(), FName("SplineMesh"));
-		USplineMeshComponent* newMesh = NewObject<USplineMeshComponent>(this, splineMeshName);
-		newMesh->SetMobility(EComponentMobility::Movable);
-		newMesh->RegisterComponent();
-		newMesh->SetStaticMesh(teleportSplineMesh);
-		newMesh->SetStartAndEnd(startPoint, FVector(0.0f), endPoint, FVector(0.0f));
-		splineMeshes.Add(newMesh);
+		// Build the arc mesh from start point to end point.
+		if (teleportArcMode == EVRTeleportArcMode::SingleMesh)
+		{
+			arcPoints.Reset();
+			arcPoints.Add(startPoint);
+			arcPoints.Add(endPoint);
+			UpdateArcMesh(arcPoints);
+		}
+		// Otherwise reshape the first spline mesh to go from start point to end point.
+		else if (splineMeshes.Num() > 0)
+		{
+			splineMeshes[0]->SetStartAndEnd(startPoint, FVector(0.0f), endPoint, FVector(0.0f));
+			ShowSplineMeshes(1);
+		}
 
 		// Set location and show the end mesh at the endPoint.
 		teleportSplineEndMesh->SetWorldLocation(endPoint, false, nullptr, ETeleportType::TeleportPhysics);
@@ -733,40 +921,53 @@ bool AVRMovement::CreateTeleportSpline(FTransform startTransform, FVector& outLo
 		return false;
 	}
 
-	// Projectile trace used to create the spline arc and find a teleport location.
-	FHitResult hit;
-	TArray<FVector> outPathPositions;
-	FVector outLastTraceDestination;
-
 	// Ignore self and ignore the player and anything thats currently held in the hand.
-	TArray<AActor*> actorsToIgnore;
-	actorsToIgnore.Add(player);
-	actorsToIgnore.Add(this);
-	actorsToIgnore.Add(currentMovingHand);
-	actorsToIgnore.Add(currentMovingHand->otherHand);
+	FCollisionQueryParams arcTraceParams(SCENE_QUERY_STAT(TeleportArc), false);
+	arcTraceParams.AddIgnoredActor(player);
+	arcTraceParams.AddIgnoredActor(this);
+	arcTraceParams.AddIgnoredActor(currentMovingHand);
+	arcTraceParams.AddIgnoredActor(currentMovingHand->otherHand);
 
-	// Projectile trace the spline hit location and use each stage of the trace to create a spline from the shape.
-	// Same way unreal do it in their VRContent examples.
-	UGameplayStatics::Blueprint_PredictProjectilePath_ByTraceChannel(GetWorld(), hit, outPathPositions, outLastTraceDestination, teleportSpline->GetComponentLocation(), teleportSpline->GetForwardVector() * teleportDistance, true, 0.0f, ECC_Teleport, false, actorsToIgnore, EDrawDebugTrace::None, 0.0f, 30.0f, 2.0f, teleportGravity);
+	// Trace the arc to find the teleport location and use the points along it to create a spline from the shape.
+	FHitResult hit;
+	FBallisticArc arc = FBallisticArc(teleportSpline->GetComponentLocation(), teleportSpline->GetForwardVector() * teleportDistance, teleportGravity);
+	TraceTeleportArc(arc, arcTraceParams, hit, arcPathPoints);
 
-	// Set the spline up from the projectile trace.
-	for (FVector splinePoint : outPathPositions)
+	// Set the spline up from the arc, only updating it once all points are added.
+	for (const FVector& splinePoint : arcPathPoints)
 	{
-		teleportSpline->AddSplinePoint(splinePoint, ESplineCoordinateSpace::World);
+		teleportSpline->AddSplinePoint(splinePoint, ESplineCoordinateSpace::World, false);
 	}
-	teleportSpline->SetSplinePointType(outPathPositions.Num() - 1, ESplinePointType::CurveClamped);
+	teleportSpline->SetSplinePointType(arcPathPoints.Num() - 1, ESplinePointType::CurveClamped, false);
+	teleportSpline->UpdateSpline();
 
-	// DO A RESOLUTION SCALE FOR SCALING DOWN HOW MANY SPLINE MESHES ARE BEING CREATED.
-	// For each spline point of the current hands spline create a spline mesh between them and add them to an array.
-	for (int i = 0; i < teleportSpline->GetNumberOfSplinePoints() - 1; i++)
+	// Build the arc mesh from the path.
+	if (teleportArcMode == EVRTeleportArcMode::SingleMesh) UpdateArcMesh(arcPathPoints);
+	else
 	{
-		FName splineMeshName = MakeUniqueObjectName(this, USplineMeshComponent::StaticClass(), FName("SplineMesh"));
-		USplineMeshComponent* newMesh = NewObject<USplineMeshComponent>(this, splineMeshName);
-		newMesh->SetMobility(EComponentMobility::Movable);
-		newMesh->RegisterComponent();
-		newMesh->SetStaticMesh(teleportSplineMesh);
-		newMesh->SetStartAndEnd(teleportSpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World), teleportSpline->GetTangentAtSplinePoint(i, ESplineCoordinateSpace::World), teleportSpline->GetLocationAtSplinePoint(i + 1, ESplineCoordinateSpace::World), teleportSpline->GetTangentAtSplinePoint(i + 1, ESplineCoordinateSpace::World));
-		splineMeshes.Add(newMesh);
+		// For each segment of the spline reshape a spline mesh from the pool to fit it.
+		const int numSegments = teleportSpline->GetNumberOfSplinePoints() - 1;
+		const int numMeshes = FMath::Min(numSegments, splineMeshes.Num());
+		if (numSegments <= splineMeshes.Num())
+		{
+			for (int i = 0; i < numMeshes; i++)
+			{
+				splineMeshes[i]->SetStartAndEnd(teleportSpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World), teleportSpline->GetTangentAtSplinePoint(i, ESplineCoordinateSpace::World), teleportSpline->GetLocationAtSplinePoint(i + 1, ESplineCoordinateSpace::World), teleportSpline->GetTangentAtSplinePoint(i + 1, ESplineCoordinateSpace::World));
+			}
+		}
+		// More segments than meshes in the pool, so spread the meshes evenly along the length of the spline instead.
+		else
+		{
+			const float segmentLength = teleportSpline->GetSplineLength() / numMeshes;
+			for (int i = 0; i < numMeshes; i++)
+			{
+				const float startDistance = segmentLength * i;
+				const float endDistance = segmentLength * (i + 1);
+				splineMeshes[i]->SetStartAndEnd(teleportSpline->GetLocationAtDistanceAlongSpline(startDistance, ESplineCoordinateSpace::World), teleportSpline->GetDirectionAtDistanceAlongSpline(startDistance, ESplineCoordinateSpace::World) * segmentLength,
+					teleportSpline->GetLocationAtDistanceAlongSpline(endDistance, ESplineCoordinateSpace::World), teleportSpline->GetDirectionAtDistanceAlongSpline(endDistance, ESplineCoordinateSpace::World) * segmentLength);
+			}
+		}
+		ShowSplineMeshes(numMeshes);
 	}
 
 	// Set location and show the end mesh of the spline.
@@ -787,34 +988,236 @@ bool AVRMovement::CreateTeleportSpline(FTransform startTransform, FVector& outLo
 	}
 }
 
-void AVRMovement::DestroyTeleportSpline()
+bool AVRMovement::TraceTeleportArc(const FBallisticArc& arc, const FCollisionQueryParams& params, FHitResult& hit, TArray<FVector>& outPathPoints)
 {
-	// Clear the spline mesh array of any components.
-	if (splineMeshes.Num() != 0)
+	const float fineStep = 1.0f / FMath::Max(teleportArcFrequency, 1.0f);
+	const float worldTime = GetWorld()->GetTimeSeconds();
+
+	// Collect last frames async sweeps first so the reuse check below sees the newest result, this also clears the handles.
+	const bool collected = asyncTeleportQueries && CollectTeleportArcTraces(params);
+
+	// Reuse last frames hit if the arc has barely moved and it hasn't been reused for too long, so nothing is traced while aiming is steady.
+	if (lastArcTraced && worldTime - lastArcTraceTime < teleportArcRefreshTime && arc.IsNearlyEqual(lastArc, teleportArcReuseDistance, teleportArcReuseAngle))
 	{
-		for (USplineMeshComponent* splineMesh : splineMeshes)
+		hit = lastArcHit;
+		arc.GetPoints(lastArcEndTime, fineStep, outPathPoints);
+		if (hit.bBlockingHit) outPathPoints.Last() = hit.Location;
+		return hit.bBlockingHit;
+	}
+
+	// Submit this frames sweeps and draw the collected result. If nothing was collected trace now so a stale hit is never used.
+	if (collected)
+	{
+		SubmitTeleportArcTraces(arc, params);
+		hit = lastArcHit;
+		arc.GetPoints(lastArcEndTime, fineStep, outPathPoints);
+		if (hit.bBlockingHit) outPathPoints.Last() = hit.Location;
+		return hit.bBlockingHit;
+	}
+
+	// Coarse segments are a whole number of fine steps, swept with a sphere big enough that the arc can't leave it.
+	const float coarseStep = fineStep * FMath::Max(teleportArcFineSteps, 1);
+	const float coarseRadius = arc.GetChordError(coarseStep) + 0.1f;
+	const int numCoarse = FMath::Max(FMath::CeilToInt(teleportArcMaxTime / coarseStep), 1);
+
+	hit = FHitResult();
+	float endTime = teleportArcMaxTime;
+	for (int coarse = 0; coarse < numCoarse && !hit.bBlockingHit; coarse++)
+	{
+		const float coarseStart = coarseStep * coarse;
+		const float coarseEnd = FMath::Min(coarseStart + coarseStep, teleportArcMaxTime);
+		FHitResult coarseHit;
+		INC_DWORD_STAT(STAT_TeleportArcTraces);
+		if (!GetWorld()->SweepSingleByChannel(coarseHit, arc.GetLocation(coarseStart), arc.GetLocation(coarseEnd), FQuat::Identity, ECC_Teleport, FCollisionShape::MakeSphere(coarseRadius), params)) continue;
+
+		// Something is near this segment so refine it, if none of its fine steps hit it was only near the arc so carry on.
+		TraceTeleportArcSegment(arc, coarse, params, hit, endTime);
+	}
+
+	// Path points along the arc up to the hit, ending exactly on it.
+	arc.GetPoints(endTime, fineStep, outPathPoints);
+	if (hit.bBlockingHit) outPathPoints.Last() = hit.Location;
+
+	// Store the result for the next frame.
+	lastArc = arc;
+	lastArcHit = hit;
+	lastArcEndTime = endTime;
+	lastArcTraceTime = worldTime;
+	lastArcTraced = true;
+
+	// Start collecting async results from the next frame.
+	if (asyncTeleportQueries) SubmitTeleportArcTraces(arc, params);
+	return hit.bBlockingHit;
+}
+
+bool AVRMovement::TraceTeleportArcSegment(const FBallisticArc& arc, int coarse, const FCollisionQueryParams& params, FHitResult& hit, float& endTime)
+{
+	const float fineStep = 1.0f / FMath::Max(teleportArcFrequency, 1.0f);
+	const int finePerCoarse = FMath::Max(teleportArcFineSteps, 1);
+	const float coarseStart = fineStep * finePerCoarse * coarse;
+	const float coarseEnd = FMath::Min(coarseStart + fineStep * finePerCoarse, teleportArcMaxTime);
+
+	// Line trace each fine step of the segment, the first to hit ends the arc.
+	for (int fine = 0; fine < finePerCoarse; fine++)
+	{
+		const float fineStart = coarseStart + fineStep * fine;
+		if (fineStart >= coarseEnd) break;
+		const float fineEnd = FMath::Min(fineStart + fineStep, coarseEnd);
+		INC_DWORD_STAT(STAT_TeleportArcTraces);
+		if (GetWorld()->LineTraceSingleByChannel(hit, arc.GetLocation(fineStart), arc.GetLocation(fineEnd), ECC_Teleport, params))
+		{
+			endTime = FMath::Lerp(fineStart, fineEnd, hit.Time);
+			return true;
+		}
+	}
+	return false;
+}
+
+void AVRMovement::SubmitTeleportArcTraces(const FBallisticArc& arc, const FCollisionQueryParams& params)
+{
+	const float coarseStep = FMath::Max(teleportArcFineSteps, 1) / FMath::Max(teleportArcFrequency, 1.0f);
+	const FCollisionShape coarseShape = FCollisionShape::MakeSphere(arc.GetChordError(coarseStep) + 0.1f);
+	const int numCoarse = FMath::Max(FMath::CeilToInt(teleportArcMaxTime / coarseStep), 1);
+
+	// Only the coarse sweeps are async, the few fine steps near a hit are traced when collected.
+	arcTraceHandles.Reset();
+	pendingArc = arc;
+	for (int coarse = 0; coarse < numCoarse; coarse++)
+	{
+		const float coarseStart = coarseStep * coarse;
+		const float coarseEnd = FMath::Min(coarseStart + coarseStep, teleportArcMaxTime);
+		INC_DWORD_STAT(STAT_TeleportArcTraces);
+		arcTraceHandles.Add(GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, arc.GetLocation(coarseStart), arc.GetLocation(coarseEnd), FQuat::Identity, ECC_Teleport, coarseShape, params));
+	}
+}
+
+bool AVRMovement::CollectTeleportArcTraces(const FCollisionQueryParams& params)
+{
+	if (arcTraceHandles.Num() == 0) return false;
+	UWorld* world = GetWorld();
+
+	// Refine the first swept segments that are near something, results are only kept for a frame so if any are missing nothing is collected.
+	bool collected = true;
+	float endTime = teleportArcMaxTime;
+	FHitResult hit;
+	for (int coarse = 0; coarse < arcTraceHandles.Num() && !hit.bBlockingHit; coarse++)
+	{
+		FTraceDatum traceData;
+		if (!world->QueryTraceData(arcTraceHandles[coarse], traceData))
 		{
-			splineMesh->DestroyComponent();
+			collected = false;
+			break;
 		}
-		splineMeshes.Empty();
+		if (traceData.OutHits.Num() > 0 && traceData.OutHits[0].bBlockingHit) TraceTeleportArcSegment(pendingArc, coarse, params, hit, endTime);
 	}
+	arcTraceHandles.Reset();
+
+	// Store the collected result so it can be drawn and reused.
+	if (collected)
+	{
+		lastArc = pendingArc;
+		lastArcHit = hit;
+		lastArcEndTime = endTime;
+		lastArcTraceTime = world->GetTimeSeconds();
+		lastArcTraced = true;
+	}
+	return collected;
+}
+
+void AVRMovement::DestroyTeleportSpline()
+{
+	// Hide the spline meshes and arc mesh, they are kept for the next time the teleport is used.
+	ShowSplineMeshes(0);
+	teleportArcMesh->SetVisibility(false);
+
+	// The next time the teleport is used the arc is traced again, any async results still pending are dropped.
+	lastArcTraced = false;
+	arcTraceHandles.Reset();
+	floorTraceHandle = FTraceHandle();
+	lastFloorOffset = 0.0f;
 
 	// Hide any of the visuals such as the end of the spline mesh, ring and arrow.
 	teleportSplineEndMesh->SetVisibility(false);
 	teleportRing->SetVisibility(false, true);
 }
 
+void AVRMovement::CreateSplineMeshPool()
+{
+	if (splineMeshes.Num() > 0) return;
+
+	// Create and register each spline mesh hidden, they are reshaped and shown when aiming.
+	for (int i = 0; i < FMath::Max(maxSplineSegments, 1); i++)
+	{
+		FName splineMeshName = MakeUniqueObjectName(this, USplineMeshComponent::StaticClass(), FName("SplineMesh"));
+		USplineMeshComponent* newMesh = NewObject<USplineMeshComponent>(this, splineMeshName);
+		newMesh->SetMobility(EComponentMobility::Movable);
+		newMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		newMesh->SetVisibility(false);
+		newMesh->RegisterComponent();
+		newMesh->SetStaticMesh(teleportSplineMesh);
+		splineMeshes.Add(newMesh);
+	}
+
+	// Force the materials to be applied to the new meshes.
+	lastMaterialValid = -1;
+}
+
+void AVRMovement::ShowSplineMeshes(int count)
+{
+	// Only change the visibility of meshes that are changing state.
+	count = FMath::Clamp(count, 0, splineMeshes.Num());
+	for (int i = FMath::Min(count, activeSplineMeshes); i < FMath::Max(count, activeSplineMeshes); i++)
+	{
+		splineMeshes[i]->SetVisibility(i < count);
+	}
+	activeSplineMeshes = count;
+}
+
+void AVRMovement::UpdateArcMesh(const TArray<FVector>& points)
+{
+	// Build on the game thread, the tube is only a couple of hundred vertices so handing it to a worker costs more than building it.
+	if (!arcBuilder.BuildVertices(points, arcMeshData))
+	{
+		teleportArcMesh->SetVisibility(false);
+		return;
+	}
+
+	// Create the section the first time, after that only the vertex buffer is updated as the vertex count never changes.
+	if (!arcMeshCreated)
+	{
+		teleportArcMesh->CreateMeshSection(0, arcMeshData.vertices, arcMeshData.triangles, arcMeshData.normals, arcMeshData.uvs, TArray<FColor>(), TArray<FProcMeshTangent>(), false);
+		if (teleportSplineMesh) teleportArcMesh->SetMaterial(0, teleportSplineMesh->GetMaterial(0));
+		arcMeshCreated = true;
+		lastMaterialValid = -1;
+	}
+	else teleportArcMesh->UpdateMeshSection(0, arcMeshData.vertices, arcMeshData.normals, arcMeshData.uvs, TArray<FColor>(), TArray<FProcMeshTangent>());
+	teleportArcMesh->SetVisibility(true);
+}
+
 bool AVRMovement::ValidateTeleportLocation(FVector& location)
 {
-	UNavigationSystemV1* navSystem = Cast<UNavigationSystemV1>(GetWorld()->GetNavigationSystem());
-	if (navSystem)
+	// Use the baked height field if there is one and it has a result for this location.
+	ATeleportHeightField* heightField = useTeleportHeightField ? ATeleportHeightField::Find(GetWorld()) : nullptr;
+	if (heightField)
+	{
+		FVector bakedLocation;
+		ETeleportCellState cellState = heightField->Lookup(location, bakedLocation);
+		if (cellState == ETeleportCellState::Valid)
+		{
+			location = bakedLocation;
+			return true;
+		}
+		else if (cellState == ETeleportCellState::Invalid) return false;
+	}
+
+	// Projections are cached as aiming often goes over the same area.
+	ANavProjectionCache* navCache = ANavProjectionCache::Get(GetWorld());
+	if (navCache)
 	{
 		// Get the nav properties from the players movement component to determine player width, height etc.
 		FVector foundLocation;
 		FVector searchingExtent = FVector(teleportSearchDistance, teleportSearchDistance, teleportSearchDistance);
-		FNavAgentProperties props = player->floatingMovement->GetNavAgentPropertiesRef();
-		ANavigationData* navData = navSystem->GetNavDataForProps(props);
-		bool locationOnNav = navSystem->K2_ProjectPointToNavigation(GetWorld(), location, foundLocation, navData, nullptr, searchingExtent);
+		bool locationOnNav = navCache->ProjectPoint(player->floatingMovement->GetNavAgentPropertiesRef(), location, searchingExtent, foundLocation);
 		// If the location is on the nav-mesh return true and set location to said found location.
 		if (locationOnNav)
 		{
@@ -823,6 +1226,20 @@ bool AVRMovement::ValidateTeleportLocation(FVector& location)
 			FCollisionQueryParams floorTraceParams;
 			floorTraceParams.AddIgnoredActor(this);
 			floorTraceParams.AddIgnoredActor(player);
+			if (asyncTeleportQueries)
+			{
+				// Keep how far last frames floor trace found the floor from the nav-mesh, then submit one for this frame. The nav-mesh is offset
+				// from the surface by about the same amount across an area so the offset is applied to this frames location while aiming moves.
+				FTraceDatum floorData;
+				if (floorTraceHandle.IsValid() && GetWorld()->QueryTraceData(floorTraceHandle, floorData))
+				{
+					const bool floorFound = floorData.OutHits.Num() > 0 && floorData.OutHits[0].bBlockingHit;
+					lastFloorOffset = floorFound ? floorData.OutHits[0].Location.Z - floorData.Start.Z : 0.0f;
+				}
+				floorTraceHandle = GetWorld()->AsyncLineTraceByObjectType(EAsyncTraceType::Single, foundLocation, foundLocation - FVector(0.0f, 0.0f, 10.0f), FCollisionObjectQueryParams(teleportableTypes), floorTraceParams);
+				location = foundLocation + FVector(0.0f, 0.0f, lastFloorOffset);
+				return true;
+			}
 			GetWorld()->LineTraceSingleByObjectType(navMeshHeightError, foundLocation, foundLocation - FVector(0.0f, 0.0f, 10.0f), teleportableTypes, floorTraceParams);
 			if (navMeshHeightError.bBlockingHit) location = navMeshHeightError.Location;
 			// Otherwise if nothing is hit just use the nav meshes assumed location as it the next best option.
@@ -836,6 +1253,10 @@ bool AVRMovement::ValidateTeleportLocation(FVector& location)
 
 void AVRMovement::UpdateTeleportMaterials(bool valid)
 {
+	// Materials are only changed when the validity changes. Hidden pooled meshes are included so they are correct when shown.
+	if (lastMaterialValid == (int8)valid) return;
+	lastMaterialValid = (int8)valid;
+
 	FLinearColor newColor = validTeleportColor;
 	if (!valid) newColor = invalidTeleportColor;
 
@@ -843,6 +1264,7 @@ void AVRMovement::UpdateTeleportMaterials(bool valid)
 	teleportSplineEndMesh->SetVectorParameterValueOnMaterials("Color", FVector(newColor.R, newColor.G, newColor.B));
 	teleportRing->SetVectorParameterValueOnMaterials("Color", FVector(newColor.R, newColor.G, newColor.B));
 	teleportArrow->SetVectorParameterValueOnMaterials("Color", FVector(newColor.R, newColor.G, newColor.B));
+	teleportArcMesh->SetVectorParameterValueOnMaterials("Color", FVector(newColor.R, newColor.G, newColor.B));
 	for (USplineMeshComponent* splineMesh : splineMeshes)
 	{
 		splineMesh->SetVectorParameterValueOnMaterials("Color", FVector(newColor.R, newColor.G, newColor.B));
@@ -853,25 +1275,19 @@ void AVRMovement::TeleportCameraFade()
 {
 	if (lastTeleportValid)
 	{
-		// If the teleport spline is still visible destroy it.
-		if (splineMeshes.Num() > 0) DestroyTeleportSpline();
-
-		// Fade the camera.
-		if (playerController) playerController->PlayerCameraManager->StartCameraFade(0.0f, 1.0f, cameraFadeTimeToLast, teleportFadeColor, false, true);
+		// Hide the teleport spline if its still visible.
+		DestroyTeleportSpline();
 
-		// Delay the teleport the amount of time it took to fade the camera.
-		FTimerHandle teleportTimer;
-		FTimerDelegate teleportTimerDel;
-		teleportTimerDel.BindUFunction(this, FName("TeleportPlayer"));
-		GetWorld()->GetTimerManager().SetTimer(teleportTimer, teleportTimerDel, cameraFadeTimeToLast, false);
+		// Fade the camera and teleport once it is faded.
+		comfortEffects.Start(EComfortEffect::Fade, 1.0f, cameraFadeTimeToLast, [this]() { TeleportPlayer(); });
 		teleporting = true;
 	}
 }
 
 void AVRMovement::TeleportPlayer()
 {
-	// If the teleport spline is still visible destroy it.
-	if (splineMeshes.Num() > 0) DestroyTeleportSpline();
+	// Hide the teleport spline if its still visible.
+	DestroyTeleportSpline();
 
 	// If in developer mode teleport capsule and raise from floor and teleport.
 	if (currentMovementMode == EVRMovementMode::Developer)
@@ -890,13 +1306,16 @@ void AVRMovement::TeleportPlayer()
 		else player->MovePlayerWithRotation(lastValidTeleportLocation, teleportRotation);
 
 		// Un-fade the camera after teleport.
-		if (teleportFade && playerController) playerController->PlayerCameraManager->StartCameraFade(1.0f, 0.0f, cameraFadeTimeToLast, teleportFadeColor, false, true);
+		if (teleportFade) comfortEffects.Start(EComfortEffect::Fade, 0.0f, cameraFadeTimeToLast);
 		teleporting = false;
 	}
 
-	// Disable the teleport.
+	// Disable the teleport and place the nav-mesh walker at the new location when walking next.
 	lastTeleportValid = false;
+#if WITH_RECAST
+	navWalker.Reset();
+#endif
 
 	// Play teleport sound if it is not null.
-	if (teleportSound) UGameplayStatics::PlaySoundAtLocation(GetWorld(), teleportSound, player->camera->GetComponentLocation());
+	if (teleportSound) AAudioVoicePool::PlaySoundAtLocation(this, teleportSound, player->camera->GetComponentLocation(), 1.0f, 1.0f, EAudioVoicePriority::High);
 }
\ No newline at end of file
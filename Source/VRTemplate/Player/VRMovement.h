@@ -5,6 +5,12 @@
 #include "GameFramework/Actor.h"
 #include "NavigationData.h"
 #include "NavQueryFilter.h"
+#include "WorldCollision.h"
+#include "Project/ArcMeshBuilder.h"
+#include "Project/BallisticArc.h"
+#include "Project/LocomotionIntegrator.h"
+#include "Project/NavMeshWalker.h"
+#include "Player/ComfortEffects.h"
 #include "Globals.h"
 #include "VRMovement.generated.h"
 
@@ -22,6 +28,9 @@ class AVRPawn;
 class AVRHand;
 class APlayerController;
 class USoundBase;
+class UProceduralMeshComponent;
+class UPrimitiveComponent;
+class ARecastNavMesh;
 
 /** Different movement modes. */
 UENUM(BlueprintType)
@@ -43,6 +52,22 @@ enum class EVRDirectionMode : uint8
 	Controller UMETA(DisplayName = "Controller", ToolTip = "For any directional movement modes use the current moving controllers look at direction to calculate relative directions."),
 };
 
+/** How the teleport arc is drawn. */
+UENUM(BlueprintType)
+enum class EVRTeleportArcMode : uint8
+{
+	SplineMeshes UMETA(DisplayName = "SplineMeshes", ToolTip = "Draw the arc with a spline mesh component for each segment of the arc."),
+	SingleMesh UMETA(DisplayName = "SingleMesh", ToolTip = "Draw the arc as a single tube mesh built inline on the game thread, only its vertex buffer is updated each frame."),
+};
+
+/** How the walking movement modes move the player. NOTE: Only used with fixed step locomotion. */
+UENUM(BlueprintType)
+enum class EVRLocomotionBackend : uint8
+{
+	Physics UMETA(DisplayName = "Physics", ToolTip = "Sweep the players capsule through the world, falling with physics when not on the ground."),
+	NavMesh UMETA(DisplayName = "NavMesh", ToolTip = "Walk the player along the nav-mesh, sliding along its edges without any physics sweeps."),
+};
+
 /** Developer input events. */
 UENUM(BlueprintType)
 enum class EVRInput : uint8
@@ -54,6 +79,39 @@ enum class EVRInput : uint8
 	HideRight,
 };
 
+/** Result of the ground probe below the players feet, cached until the player or the floor moves. */
+USTRUCT(BlueprintType)
+struct FVRGroundData
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Is the player standing on the ground. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ground")
+	bool onGround;
+
+	/** Location on the ground below the players feet. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ground")
+	FVector location;
+
+	/** Normal of the ground. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ground")
+	FVector normal;
+
+	/** The ground component. */
+	UPROPERTY()
+	TWeakObjectPtr<UPrimitiveComponent> floor;
+
+	/** Constructor. */
+	FVRGroundData()
+	{
+		this->onGround = false;
+		this->location = FVector::ZeroVector;
+		this->normal = FVector::UpVector;
+	}
+};
+
 /** The VRPawns Movement component class containing all virtual reality movement functionality.
  * NOTE: If movement mode is changed during runtime the SetupMovement function must be ran afterwards for the class to work correctly... */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent), Blueprintable, BlueprintType, hidecategories = (Rendering, Replication, Input, Actor, LOD, Cooking))
@@ -83,6 +141,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 	UStaticMeshComponent* teleportSplineEndMesh;
 
+	/** Tube mesh the teleport arc is built into when using the single mesh arc mode. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
+	UProceduralMeshComponent* teleportArcMesh;
+
 	/** Mesh to be procedurally placed along the teleport spline. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 	UStaticMesh* teleportSplineMesh;
@@ -152,6 +214,60 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "0.0", UIMin = "100.0", ClampMax = "0.0", UIMax = "100.0"))
 	float teleportSearchDistance;
 
+	/** Number of fine steps per second along the teleport arc, these make up the points of the drawn arc and are traced near hits. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "1.0", UIMin = "10.0", UIMax = "60.0"))
+	float teleportArcFrequency;
+
+	/** Max time along the teleport arc, the arc is this long if nothing is hit. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "0.1", UIMin = "0.5", UIMax = "5.0"))
+	float teleportArcMaxTime;
+
+	/** Number of fine steps in each coarse segment of the teleport arc. Coarse segments are swept first and only those near something are traced in fine steps. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "1", UIMin = "1", UIMax = "16"))
+	int teleportArcFineSteps;
+
+	/** Max distance the start of the teleport arc can move for last frames hit to be reused. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "5.0"))
+	float teleportArcReuseDistance;
+
+	/** Max angle in degrees the teleport arc can turn for last frames hit to be reused. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "5.0"))
+	float teleportArcReuseAngle;
+
+	/** Max time a teleport arc hit can be reused before it is traced again, so moving objects are still picked up while aiming is steady. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "1.0"))
+	float teleportArcRefreshTime;
+
+	/** Validate teleport locations with the baked teleport height field in the level if there is one, only checking the nav-mesh for cells it can't answer. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport")
+	bool useTeleportHeightField;
+
+	/** Submit the coarse teleport arc sweeps and the floor trace as async traces and use their results the next frame, taking them off the game thread.
+	 * Only the fine steps of a swept segment that is near something are traced on the game thread.
+	 * NOTE: The teleport location is a frame behind the hand. The nav-mesh projection is still ran on the game thread as it isn't safe while tiles rebuild. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport")
+	bool asyncTeleportQueries;
+
+	/** How the teleport arc is drawn. NOTE: The single mesh mode uses the material of the teleport spline mesh. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport")
+	EVRTeleportArcMode teleportArcMode;
+
+	/** Number of rings along the tube in the single mesh arc mode. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "2", UIMin = "2", UIMax = "64"))
+	int teleportArcRings;
+
+	/** Number of sides around the tube in the single mesh arc mode. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "3", UIMin = "3", UIMax = "16"))
+	int teleportArcSides;
+
+	/** Radius of the tube in the single mesh arc mode. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "0.0", UIMin = "0.1", UIMax = "5.0"))
+	float teleportArcRadius;
+
+	/** Number of spline mesh segments created up front and reused to draw the teleport arc. Arcs with more points are resampled to fit. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement|Teleport", meta = (ClampMin = "1", UIMin = "1", UIMax = "64"))
+	int maxSplineSegments;
+
 	/** Move direction is relative to the camera where as if this is false move direction will be relative to world. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement")
 	bool cameraMoveDirection;
@@ -168,11 +284,35 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement", meta = (ClampMin = "100.0", UIMin = "100.0", ClampMax = "300.0", UIMax = "300.0"))
 	float walkingSpeed;
 
+	/** Simulate the walking movement modes at a fixed rate and apply the result as a single sweep each frame, so movement is the same at any frame rate. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement")
+	bool fixedStepLocomotion;
+
+	/** Steps per second of the fixed step locomotion. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement", meta = (ClampMin = "30.0", UIMin = "60.0", UIMax = "240.0"))
+	float locomotionStepRate;
+
+	/** Max steps of the fixed step locomotion in a single frame, time over this during a hitch is dropped. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement", meta = (ClampMin = "1", UIMin = "1", UIMax = "16"))
+	int maxLocomotionSubsteps;
+
+	/** How the walking movement modes move the player. NOTE: Only used with fixed step locomotion. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement", meta = (EditCondition = "fixedStepLocomotion"))
+	EVRLocomotionBackend locomotionBackend;
+
+	/** Distance around the players feet to search for the nav-mesh when they start walking on it. NOTE: Only used with the nav-mesh locomotion backend. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement", meta = (EditCondition = "fixedStepLocomotion", ClampMin = "0.0", UIMin = "0.0", UIMax = "200.0"))
+	float navWalkingSearchDistance;
+
+	/** Distance the players feet can move before the ground below them is traced again. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement", meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "5.0"))
+	float groundProbeDistance;
+
 	/** Will the peripherals be darkened during walking movement to decrease motion sickness. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement")
 	bool vignetteDuringMovement;
 
-	/** Vignette transition speed between 1 and 0 on its material instances opacity scale. */
+	/** Vignette transition speed between 1 and 0 on its material instances opacity scale, a full transition takes 3 / speed seconds. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|WalkingMovement")
 	float vignetteTransitionSpeed;
 
@@ -217,6 +357,17 @@ private:
 	bool inAir;// Is the player currently in the air.
 	FVector originalMovementLocation;
 	FVector lastMovementLocation;
+	FLocomotionIntegrator locomotion; /** Fixed step simulation of the walking movement modes. */
+	FVector locomotionInput; /** Movement input added this frame, consumed in tick. */
+	FVRGroundData groundData; /** Cached result of the ground probe. */
+	FVector groundProbeLocation; /** Location of the players feet at the last ground probe. */
+	FTransform groundFloorTransform; /** Transform of the floor at the last ground probe. */
+	FCollisionQueryParams groundProbeParams; /** Query params for the ground probe, kept between probes. */
+	bool groundProbed; /** Has the ground been probed since setup. */
+	TWeakObjectPtr<ARecastNavMesh> walkingNavMesh; /** Nav-mesh of the players agent walked on by the nav-mesh locomotion backend. */
+#if WITH_RECAST
+	FNavMeshWalker navWalker; /** Keeps the players feet on the nav-mesh for the nav-mesh locomotion backend. */
+#endif
 
 	/////////////////////////////////////////////////
 	//			    Teleporting Vars.			   //
@@ -227,16 +378,31 @@ private:
 	float teleportWidth;
 	FVector lastValidTeleportLocation;
 	FRotator teleportRotation;
-	TArray<class USplineMeshComponent*> splineMeshes;
+	TArray<class USplineMeshComponent*> splineMeshes; /** Pool of registered spline meshes, never destroyed while aiming. */
+	int activeSplineMeshes; /** Number of spline meshes from the pool currently shown. */
+	int8 lastMaterialValid; /** Last validity applied to the teleport materials, -1 if not yet applied. */
+	FArcMeshBuilder arcBuilder; /** Builds the tube for the single mesh arc mode. */
+	FArcMeshData arcMeshData; /** Mesh data for the arc, kept between builds so rebuilding doesn't allocate. */
+	TArray<FVector> arcPoints; /** Path points for the cancelled arc, kept to avoid reallocating each frame. */
+	bool arcMeshCreated; /** Has the arc mesh section been created, after which only its vertices are updated. */
+	TArray<FVector> arcPathPoints; /** Points along the traced teleport arc, kept to avoid reallocating each frame. */
+	FBallisticArc lastArc; /** The last teleport arc that was traced. */
+	FHitResult lastArcHit; /** The hit of the last traced teleport arc. */
+	float lastArcEndTime; /** Time along the last traced teleport arc that it ended. */
+	float lastArcTraceTime; /** World time the last teleport arc was traced. */
+	bool lastArcTraced; /** Has a teleport arc been traced that can be reused. */
+	FBallisticArc pendingArc; /** The arc the pending async traces were submitted for. */
+	TArray<FTraceHandle> arcTraceHandles; /** Async sweeps for each coarse segment of the pending arc, collected next frame. */
+	FTraceHandle floorTraceHandle; /** Async floor trace below the last nav-mesh location, collected next frame. */
+	float lastFloorOffset; /** Height of the floor from the nav-mesh found by the last collected async floor trace. */
 
 	/////////////////////////////////////////////////
 	//			     Vignette Vars.			       //
 	/////////////////////////////////////////////////
 
 	UMaterialInstanceDynamic* vignetteMAT;
-	float lastVignetteOpacity;
-	FTimerHandle vignetteTimer;
 	bool canApplyVignette;
+	FComfortEffects comfortEffects; /** Animates the vignette and camera fade. */
 
 	/////////////////////////////////////////////////
 	//			   Development Vars.			   //
@@ -272,6 +438,26 @@ public:
 	/** Function to update while the teleport button is down. */
 	void UpdateControllerMovement(AVRHand* movementHand);
 
+	/** Step the fixed step locomotion with this frames input and sweep the player by the result. */
+	void UpdateLocomotion(float deltaTime);
+
+	/** @Return true if the player is walked along the nav-mesh instead of swept through the world. */
+	bool UsingNavMeshLocomotion() const { return fixedStepLocomotion && locomotionBackend == EVRLocomotionBackend::NavMesh; }
+
+	/** Move the player along the nav-mesh, sliding along its edges.
+	 * @Param movement, The movement to apply.
+	 * @Return false if the player isn't on the nav-mesh. */
+	bool MoveOnNavMesh(const FVector& movement);
+
+	/** Trace for the ground below the players feet if they or the floor have moved since the last probe, otherwise return the cached result.
+	 * @Param force, Trace even if nothing has moved.
+	 * @Return the ground below the players feet. */
+	const FVRGroundData& UpdateGroundProbe(bool force = false);
+
+	/** @Return the ground below the players feet from the last ground probe. */
+	UFUNCTION(BlueprintPure, Category = "Movement")
+	FVRGroundData GetGroundData() const { return groundData; }
+
 	/** Function to interpolate vignette opacity back to 1.0 (invisible). */
 	UFUNCTION(BlueprintCallable, Category = "WalkingMovement")
 	void ResetVignette();
@@ -279,6 +465,9 @@ public:
 	/** Interpolates the vignettes opacity value stored in the vignetteMAT variable to a specified target. */
 	void LerpVignette(float target);
 
+	/** Advance the comfort effects and write any that changed to the vignette material and camera. */
+	void UpdateComfortEffects(float deltaTime);
+
 	/////////////////////////////////////////////////
 	//			Teleporting Functions.			   //
 	/////////////////////////////////////////////////
@@ -289,9 +478,45 @@ public:
 	/** Returns weather or not the teleport spline has hit anything, also updated outLocation. */
 	bool CreateTeleportSpline(FTransform startTransform, FVector& outLocation);
 
-	/** Removes all spline meshes and hides any teleport components. */
+	/** Trace along the teleport arc in coarse segments, refining only near hits, or reuse last frames hit if the arc has barely moved.
+	 * @Param arc, The arc to trace.
+	 * @Param params, Query params for the traces.
+	 * @Param hit, The hit along the arc.
+	 * @Param outPathPoints, Points along the arc ending at the hit or the max arc time.
+	 * @Return true if something was hit. */
+	bool TraceTeleportArc(const FBallisticArc& arc, const FCollisionQueryParams& params, FHitResult& hit, TArray<FVector>& outPathPoints);
+
+	/** Line trace the fine steps of a coarse segment of the arc.
+	 * @Param arc, The arc to trace.
+	 * @Param coarse, Index of the coarse segment.
+	 * @Param params, Query params for the traces.
+	 * @Param hit, The hit of the first fine step to hit something.
+	 * @Param endTime, Set to the time along the arc of the hit.
+	 * @Return true if something was hit. */
+	bool TraceTeleportArcSegment(const FBallisticArc& arc, int coarse, const FCollisionQueryParams& params, FHitResult& hit, float& endTime);
+
+	/** Submit async sweeps of each coarse segment of the arc to be collected next frame.
+	 * @Param arc, The arc to submit sweeps for.
+	 * @Param params, Query params for the sweeps. */
+	void SubmitTeleportArcTraces(const FBallisticArc& arc, const FCollisionQueryParams& params);
+
+	/** Collect last frames async sweeps, refining any that hit, and store the result as the last traced arc. Always clears the pending sweeps.
+	 * @Param params, Query params for the refining traces.
+	 * @Return true if results were collected. */
+	bool CollectTeleportArcTraces(const FCollisionQueryParams& params);
+
+	/** Hides all spline meshes and any teleport components. */
 	void DestroyTeleportSpline();
 
+	/** Create and register the pool of spline meshes used to draw the teleport arc. Does nothing if the pool already exists. */
+	void CreateSplineMeshPool();
+
+	/** Show the first count spline meshes in the pool and hide the rest. */
+	void ShowSplineMeshes(int count);
+
+	/** Build the arc mesh along the given points and upload its vertices. */
+	void UpdateArcMesh(const TArray<FVector>& points);
+
 	/** Check if area is a valid teleport location. */
 	bool ValidateTeleportLocation(FVector& location);
 
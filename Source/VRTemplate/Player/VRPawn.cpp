@@ -26,6 +26,7 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "Components/WidgetInteractionComponent.h"
 #include "Project/EffectsContainer.h"
+#include "Project/CollisionClearanceService.h"
 
 DEFINE_LOG_CATEGORY(LogVRPawn);
 
@@ -189,6 +190,10 @@ void AVRPawn::PostUpdateTick(float DeltaTime)
 
 	// Update the current collision properties based from the tracking of the HMD and then each hand to prevent physics actors being affected by repositioning these components.
 	if (!devModeActive) UpdateHardwareTrackingState();
+
+	// Send each hands mixed haptic feedback for this frame to the controllers.
+	if (leftHand) leftHand->FlushFeedback();
+	if (rightHand) rightHand->FlushFeedback();
 }
 
 void AVRPawn::Teleported()
@@ -534,36 +539,30 @@ void AVRPawn::ActivateAllCollision(bool enable)
 
 void AVRPawn::ActivateCollision(bool enable)
 {
+	ACollisionClearanceService* clearanceService = ACollisionClearanceService::Get(GetWorld());
 	if (enable)
 	{
 		// Don't re-enable the collision until the hands and head Collider are no longer overlapping anything, this resolves teleporting bugs etc.
 		headCollider->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-		FTimerDelegate timerDel;
-		timerDel.BindUFunction(this, FName("CollisionDelay"));
-		GetWorld()->GetTimerManager().SetTimer(headColDelay, timerDel, 0.01f, true);
+		if (clearanceService)
+		{
+			clearanceService->WaitUntilClear(headCollider, physicsColliders, actorsToIgnore, FOnCollisionClear::CreateUObject(this, &AVRPawn::HeadColliderClear));
+		}
 		collisionEnabled = true;
 	}
 	else
 	{
 		// Disable the head Collider collision along with both hands.
 		headCollider->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		if (clearanceService) clearanceService->CancelWait(headCollider);
 		collisionEnabled = false;
 	}
 }
 
-void AVRPawn::CollisionDelay()
+void AVRPawn::HeadColliderClear()
 {
-	// Check if the given collisionComponent is currently overlapping a blocking physics collision.
-	TArray<UPrimitiveComponent*> overlappingComps;
-	bool overlapping = UKismetSystemLibrary::ComponentOverlapComponents(headCollider, headCollider->GetComponentTransform(), physicsColliders, nullptr, actorsToIgnore, overlappingComps);
-	
-	// If no longer overlapping re-enable the collision on the head Collider to query and physics.
-	if (!overlapping)
-	{
-		// Stop this function once the collision is re-enabled.
-		headCollider->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		GetWorld()->GetTimerManager().ClearTimer(headColDelay);
-	}
+	// No longer overlapping, re-enable the collision on the head Collider to query and physics.
+	headCollider->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 }
 
 UEffectsContainer* AVRPawn::GetPawnEffects()
@@ -126,7 +126,6 @@ public:
 private:
 
 	bool collisionEnabled; /** This classes components are blocking physics simulated components. */
-	FTimerHandle headColDelay; /** Timer handle for the collision delay when the collision will be re-enabled on the head Collider. Also some timer handles for the hands. */
 	FXRDeviceId hmdDevice; /** Device ID for the current HMD device that is being used. */
 	AVRHand* movingHand; /** The hand that is currently initiating movement for the VRPawn. */
 
@@ -185,9 +184,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Pawn|Collision")
 	void ActivateCollision(bool enable);
 
-	/** Looping function every 0.1 seconds checking if the head Collider is currently overlapping physics etc. If not re-enable collision, until then loop and check. */
-	UFUNCTION(Category = "Pawn|Collision")
-	void CollisionDelay();
+	/** Called by the collision clearance service once the head Collider is no longer overlapping physics etc. Re-enables the head collision. */
+	void HeadColliderClear();
 
 	/** Get the effects container from the pawn. So hands and other interactables can obtain default effects for rumbling or audio feedback. */
 	UFUNCTION(BlueprintCallable, Category = "Pawn|Collision")
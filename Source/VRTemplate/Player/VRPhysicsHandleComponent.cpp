@@ -1,18 +1,13 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Player/VRPhysicsHandleComponent.h"
+#include "Project/PhysicsHandleManager.h"
+#include "Project/HandlePhysicsBackend.h"
+#include "Player/PosePredictor.h"
 #include "EngineDefines.h"
-#include "PhysxUserData.h"
 #include "Components/PrimitiveComponent.h"
-#include "PhysicsPublic.h"
-#include "Physics/PhysicsInterfaceCore.h"
-#include "PhysXIncludes.h"
 #include "DrawDebugHelpers.h"
 
-#if WITH_PHYSX
-#include "PhysXPublic.h"
-#endif 
-
 DEFINE_LOG_CATEGORY(LogVRHandle);
 
 UVRPhysicsHandleComponent::UVRPhysicsHandleComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -29,6 +24,12 @@ UVRPhysicsHandleComponent::UVRPhysicsHandleComponent(const FObjectInitializer& O
  	grabbedComponent = nullptr;
  	targetComponent = nullptr;
  	grabbedBoneName = NAME_None;
+	jointId = INDEX_NONE;
+	batchedUpdate = true;
+	substepMode = EHandleSubstepMode::Disabled;
+
+	// Bind the substep callback.
+	onCalculateCustomPhysics.BindUObject(this, &UVRPhysicsHandleComponent::SubstepTick);
 }
 
 void UVRPhysicsHandleComponent::OnUnregister()
@@ -38,29 +39,17 @@ void UVRPhysicsHandleComponent::OnUnregister()
  		DestroyJoint();
  	}
  
- #if WITH_PHYSX
- 	if (joint)
+ 	if (jointId != INDEX_NONE)
  	{
- 		check(targetActor);
- 
- 		// use correct scene
- 		PxScene* jointScene = joint->getScene();
- 		if (jointScene)
- 		{
- 			jointScene->lockWrite();
- 
- 			// destroy joint
- 			joint->release();
- 			joint = NULL;
- 
- 			// Destroy temporary actor.
- 			targetActor->release();
- 			targetActor = NULL;
- 
- 			jointScene->unlockWrite();
- 		}
+		ReleaseJoint();
  	}
- #endif // WITH_PHYSX
+
+	// Stop being updated by the manager.
+	if (manager.IsValid())
+	{
+		manager->UnregisterHandle(this);
+		manager = nullptr;
+	}
 
 	Super::OnUnregister();
 }
@@ -71,12 +60,29 @@ void UVRPhysicsHandleComponent::BeginPlay()
  
  	// Save the original handle data.
  	originalData = handleData;
+
+	// Get the manager to pool joints from, and let it update this handle instead of ticking.
+	manager = APhysicsHandleManager::Get(GetWorld());
+	if (batchedUpdate && manager.IsValid())
+	{
+		manager->RegisterHandle(this);
+		SetComponentTickEnabled(false);
+	}
 }
 
 void UVRPhysicsHandleComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
- 
+
+	// Only ticks when not updated by the manager. The substeps move the target when using them.
+	UpdateTarget(DeltaTime);
+ 	if (!UsingSubsteps()) UpdateHandleTransform(currentTransform);
+}
+
+void UVRPhysicsHandleComponent::UpdateTarget(float DeltaTime)
+{
+	const FTransform lastTransform = currentTransform;
+
  	// If the targetComponent is valid update the target transform to the new target location.
  	if (handleData.updateTargetLocation && targetComponent)
  	{
@@ -95,7 +101,7 @@ void UVRPhysicsHandleComponent::TickComponent(float DeltaTime, enum ELevelTick T
  	// If interpolation has been enabled perform blend between the current transform and the target at the given interpolation speed.
  	if (handleData.interpolate)
  	{
- 		float alpha = FMath::Clamp(DeltaTime * handleData.interpSpeed, 0.0f, 1.0f);
+ 		float alpha = GetSmoothingAlpha(handleData.interpSpeed, DeltaTime);
  		FTransform normalisedCurrent = currentTransform;
  		FTransform normalisedTarget = targetTransform;
  		normalisedCurrent.NormalizeRotation();
@@ -107,9 +113,67 @@ void UVRPhysicsHandleComponent::TickComponent(float DeltaTime, enum ELevelTick T
  	{
  		currentTransform = targetTransform;
  	}
- 
- 	// Update the transform of the physics handle.
- 	UpdateHandleTransform(currentTransform);
+
+	// Let the physics substeps move the target from where it was last frame.
+	if (UsingSubsteps()) QueueSubsteps(DeltaTime, lastTransform);
+}
+
+float UVRPhysicsHandleComponent::GetSmoothingAlpha(float speed, float deltaTime)
+{
+	if (speed < 0.0f) return 1.0f;
+	return 1.0f - FMath::Exp(-speed * FMath::Max(deltaTime, 0.0f));
+}
+
+void UVRPhysicsHandleComponent::QueueSubsteps(float DeltaTime, const FTransform& lastTransform)
+{
+	RETURN(!grabbedComponent || DeltaTime <= SMALL_NUMBER);
+	FBodyInstance* bodyInstance = grabbedComponent->GetBodyInstance(grabbedBoneName);
+	RETURN(!bodyInstance);
+
+	// Copy the targets motion over this frame for the substeps, they are ran from the physics thread while the game thread carries on.
+	substepState.backend = GetBackend();
+	substepState.jointId = jointId;
+	substepState.mode = substepMode;
+	substepState.startTransform = lastTransform;
+	substepState.endTransform = currentTransform;
+	substepState.linearVelocity = (currentTransform.GetLocation() - lastTransform.GetLocation()) / DeltaTime;
+	FQuat deltaRotation = currentTransform.GetRotation() * lastTransform.GetRotation().Inverse();
+	if (deltaRotation.W < 0.0f) deltaRotation = deltaRotation * -1.0f;
+	FVector axis;
+	float angle;
+	deltaRotation.ToAxisAndAngle(axis, angle);
+	substepState.angularVelocity = axis * (angle / DeltaTime);
+	substepState.frameTime = DeltaTime;
+	substepState.time = 0.0f;
+
+	// Custom physics is cleared after each physics step so must be added every frame.
+	bodyInstance->AddCustomPhysics(onCalculateCustomPhysics);
+}
+
+void UVRPhysicsHandleComponent::SubstepTick(float DeltaTime, FBodyInstance* bodyInstance)
+{
+	// Only the queued substep state is used, the rest of the handle belongs to the game thread.
+	FHandleSubstepState& state = substepState;
+	RETURN(state.jointId == INDEX_NONE || !state.backend || state.frameTime <= SMALL_NUMBER);
+
+	// The target set now is reached at the end of this substep.
+	state.time = FMath::Min(state.time + DeltaTime, state.frameTime);
+	FTransform substepTransform = state.endTransform;
+	if (state.mode == EHandleSubstepMode::Interpolate)
+	{
+		const float alpha = state.time / state.frameTime;
+		substepTransform.SetLocation(FMath::Lerp(state.startTransform.GetLocation(), state.endTransform.GetLocation(), alpha));
+		substepTransform.SetRotation(FQuat::Slerp(state.startTransform.GetRotation(), state.endTransform.GetRotation(), alpha));
+	}
+	else
+	{
+		FVector location;
+		FQuat rotation;
+		FPosePredictor::Extrapolate(state.endTransform.GetLocation(), state.endTransform.GetRotation(), state.linearVelocity, state.angularVelocity, state.time, location, rotation);
+		substepTransform.SetLocation(location);
+		substepTransform.SetRotation(rotation);
+	}
+	MoveTarget_AssumesLocked(state.backend, state.jointId, substepTransform);
 }
 
 void UVRPhysicsHandleComponent::K2_CreateJointAndFollowLocationTarget(UPrimitiveComponent* comp, UPrimitiveComponent* target, FName boneName, 
@@ -164,65 +228,31 @@ void UVRPhysicsHandleComponent::CreateJoint(UPrimitiveComponent* comp, UPrimitiv
  	// If the component is null throw log and return.
  	CHECK_RETURN(LogVRHandle, !comp, "The VR Physics Handle %s, cannot create a joint as the given component is null.", *GetName());
  
- #if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
- 	// Get the PxRigidDynamic that we want to grab.
- 	FBodyInstance* BodyInstance = comp->GetBodyInstance(boneName);
- 	if (!BodyInstance)
- 	{
- 		return;
- 	}
+	// Get the backend to create the joint with.
+	if (!manager.IsValid()) manager = APhysicsHandleManager::Get(GetWorld());
+	CHECK_RETURN(LogVRHandle, !manager.IsValid(), "The VR Physics Handle %s, cannot create a joint as there is no physics handle manager.", *GetName());
+	IHandlePhysicsBackend* backend = manager->GetBackend();
 
-	// Get actor handle.
-	const FPhysicsActorHandle& ActorHandle = BodyInstance->GetPhysicsActorHandle();
- 	FPhysicsCommand::ExecuteWrite(ActorHandle, [&](const FPhysicsActorHandle& Actor)
- 	{
- 		if (PxRigidActor* phsyActor = FPhysicsInterface::GetPxRigidActor_AssumesLocked(Actor))
- 		{
- 			PxScene* scene = phsyActor->getScene();
- 
- 			// If a valid handle has been passed into this function use it as this joints data.
- 			if (interactableData.handleDataEnabled) handleData = interactableData;
- 
- 			// Create the transform location of the joint to be created.
- 			PxTransform grabbedActorPose = phsyActor->getGlobalPose();
- 			PxTransform jointTransform(U2PVector(grabLocation), U2PQuat(grabOrientation.Quaternion()));
- 
- 			// Ensure the target and current transform are the same on initial creation of this joint.
- 			targetTransform = currentTransform = P2UTransform(jointTransform);
- 
- 			// If we don't already have a handle make one now.
- 			if (!joint)
- 			{
- 				// Create kinematic actor we are going to create joint with. This will be moved around with calls to SetLocation/SetRotation.
- 				PxRigidDynamic* newTarget = scene->getPhysics().createRigidDynamic(jointTransform);
- 				newTarget->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
- 				newTarget->setMass(1.0f);
- 				newTarget->setMassSpaceInertiaTensor(PxVec3(1.0f, 1.0f, 1.0f));
- 				newTarget->userData = NULL;
- 
- 				// Add to Scene and Update data reference.
- 				scene->addActor(*newTarget);
-  				targetActor = newTarget;
- 
- 				// Create the joint with the new joint transform.
- 				PxD6Joint* newJoint = PxD6JointCreate(scene->getPhysics(), targetActor, PxTransform(PxIdentity), phsyActor, grabbedActorPose.transformInv(jointTransform));
- 				if (!newJoint)
- 				{
- 					joint = 0;
- 				}
- 				else
- 				{
- 					// Setup the joint properties.
- 					newJoint->userData = NULL;
- 					joint = newJoint;
- 					rotationConstraint = constrainRotation;
- 					ReinitJoint();
- 				}
- 			}
- 		}
- 	});
- 
- #endif // WITH_PHYSX
+	// If a valid handle has been passed into this function use it as this joints data.
+	if (interactableData.handleDataEnabled) handleData = interactableData;
+
+	// Ensure the target and current transform are the same on initial creation of this joint.
+	const FTransform jointTransform(grabOrientation, grabLocation);
+	targetTransform = currentTransform = jointTransform;
+
+	// If we don't already have a joint create one now, the kinematic target is moved around with calls to SetLocation/SetRotation.
+	if (jointId == INDEX_NONE)
+	{
+		jointId = backend->CreateJoint(comp, boneName, jointTransform);
+		if (jointId == INDEX_NONE)
+		{
+			return;
+		}
+
+		// Setup the joint properties.
+		rotationConstraint = constrainRotation;
+		ReinitJoint();
+	}
  
  	// Save variables to keep track of grabbed state.
  	grabbedComponent = comp;
@@ -241,6 +271,9 @@ void UVRPhysicsHandleComponent::CreateJoint(UPrimitiveComponent* comp, UPrimitiv
  		FVector targetLocOffset = targetComponent->GetComponentTransform().InverseTransformPositionNoScale(grabLocation);
  		FRotator targetRotOffset = targetComponent->GetComponentTransform().InverseTransformRotation(grabOrientation.Quaternion()).Rotator();
  		targetOffset = FTransform(targetRotOffset, targetLocOffset, targetTransform.GetScale3D());
+
+		// Make sure the manager updates this handle after the target has moved.
+		if (manager.IsValid()) manager->AddTickPrerequisites(targetComponent->GetOwner());
  	}
  	// Otherwise disable update target location.
  	else handleData.updateTargetLocation = false;
@@ -248,28 +281,12 @@ void UVRPhysicsHandleComponent::CreateJoint(UPrimitiveComponent* comp, UPrimitiv
 
 void UVRPhysicsHandleComponent::DestroyJoint()
 {
- 	// Destroy all physX actors.
- #if WITH_PHYSX
+ 	// Destroy the joint and its target.
  	if (grabbedComponent)
  	{
- 		if (joint)
+ 		if (jointId != INDEX_NONE)
  		{
- 			check(targetActor);
- 
- 			// use correct scene
- 			PxScene* jointScene = joint->getScene();
- 			if (jointScene)
- 			{
- 				SCOPED_SCENE_WRITE_LOCK(jointScene);
- 				// Destroy joint.
- 				joint->release();
- 
- 				// Destroy temporary actor.
- 				targetActor->release();
- 
- 			}
- 			targetActor = NULL;
- 			joint = NULL;
+			ReleaseJoint();
  		}
  
  		// Reset any grabbed pointers/variables also.
@@ -283,7 +300,6 @@ void UVRPhysicsHandleComponent::DestroyJoint()
  		currentTransform = FTransform();
  		targetTransform = FTransform();
  	}
- #endif
 }
 
 FTransform UVRPhysicsHandleComponent::GetTargetLocation()
@@ -333,46 +349,83 @@ void UVRPhysicsHandleComponent::SetTarget(FTransform newTargetTransform, bool up
 
 void UVRPhysicsHandleComponent::UpdateHandleTransform(const FTransform& updatedTransform)
 {
- 	if (!targetActor)
+	IHandlePhysicsBackend* backend = GetBackend();
+ 	if (jointId == INDEX_NONE || !backend)
  	{
  		return;
  	}
  
- #if WITH_PHYSX
- 	PxScene* targetScene = targetActor->getScene();
- 	SCOPED_SCENE_WRITE_LOCK(targetScene);
- 
- 	// Has the new transform location been changed enough to apply.
- 	PxVec3 newTargetLoc = U2PVector(updatedTransform.GetTranslation());
- 	PxVec3 currentTargetLoc = targetActor->getGlobalPose().p;
- 	bool changedPos = true;
- 	if ((newTargetLoc - currentTargetLoc).magnitudeSquared() <= 0.01f * 0.01f)
- 	{ 
- 		newTargetLoc = currentTargetLoc;
- 		changedPos = false;
- 	}
- 
- 	// Has the new transform rotation been changed enough to apply orientation change.
- 	PxQuat newTargetOrientation = U2PQuat(updatedTransform.GetRotation());
- 	PxQuat currentTargetOrientation = targetActor->getGlobalPose().q;
- 	bool changedRot = true;
- 	if ((FMath::Abs(newTargetOrientation.dot(currentTargetOrientation)) > (1.0f - SMALL_NUMBER)))
- 	{
- 		newTargetOrientation = currentTargetOrientation;
- 		changedRot = false;
- 	}
- 
- 	// If the location or rotation has been changed apply new kinematic target to the PhysX Actor.
- 	if (changedPos || changedRot)
- 	{
- 		targetActor->setKinematicTarget(PxTransform(newTargetLoc, newTargetOrientation));
- 	}
- 
- #if WITH_EDITOR
- 	// Log the new hand target location as a blue point.
- 	if (debug) DrawDebugPoint(GetWorld(), updatedTransform.GetTranslation(), 5.0f, FColor::Blue, true, 0.1f, 0.0f);
- #endif // END EDITOR
- #endif // END PhysX
+	backend->ExecuteWrite([&]()
+	{
+		ApplyHandleTransform_AssumesLocked(updatedTransform);
+	});
+}
+
+void UVRPhysicsHandleComponent::ApplyHandleTransform_AssumesLocked(const FTransform& updatedTransform)
+{
+	IHandlePhysicsBackend* backend = GetBackend();
+	if (jointId == INDEX_NONE || !backend)
+	{
+		return;
+	}
+	MoveTarget_AssumesLocked(backend, jointId, updatedTransform);
+
+#if WITH_EDITOR
+	// Log the new hand target location as a blue point.
+	if (debug) DrawDebugPoint(GetWorld(), updatedTransform.GetTranslation(), 5.0f, FColor::Blue, true, 0.1f, 0.0f);
+#endif // END EDITOR
+}
+
+void UVRPhysicsHandleComponent::MoveTarget_AssumesLocked(IHandlePhysicsBackend* backend, int32 joint, const FTransform& updatedTransform)
+{
+	// Has the new transform location been changed enough to apply.
+	const FTransform currentTarget = backend->GetTargetPose_AssumesLocked(joint);
+	FVector newTargetLoc = updatedTransform.GetTranslation();
+	bool changedPos = true;
+	if (FVector::DistSquared(newTargetLoc, currentTarget.GetTranslation()) <= 0.01f * 0.01f)
+	{
+		newTargetLoc = currentTarget.GetTranslation();
+		changedPos = false;
+	}
+
+	// Has the new transform rotation been changed enough to apply orientation change.
+	FQuat newTargetOrientation = updatedTransform.GetRotation();
+	bool changedRot = true;
+	if (FMath::Abs(newTargetOrientation | currentTarget.GetRotation()) > (1.0f - SMALL_NUMBER))
+	{
+		newTargetOrientation = currentTarget.GetRotation();
+		changedRot = false;
+	}
+
+	// If the location or rotation has been changed apply new kinematic target.
+	if (changedPos || changedRot)
+	{
+		backend->SetTargetPose_AssumesLocked(joint, FTransform(newTargetOrientation, newTargetLoc));
+	}
+}
+
+IHandlePhysicsBackend* UVRPhysicsHandleComponent::GetBackend() const
+{
+	return manager.IsValid() ? manager->GetBackend() : nullptr;
+}
+
+bool UVRPhysicsHandleComponent::UsingSubsteps() const
+{
+	IHandlePhysicsBackend* backend = GetBackend();
+	return substepMode != EHandleSubstepMode::Disabled && jointId != INDEX_NONE && backend && backend->IsSubstepping();
+}
+
+void UVRPhysicsHandleComponent::ReleaseJoint()
+{
+	// Return the joint to the backend, if the manager has gone the world is being torn down with the joint.
+	// Stop any queued substeps moving it under the scene lock they are ran in, as the joint may be reused by another handle this frame.
+	if (IHandlePhysicsBackend* backend = GetBackend())
+	{
+		if (substepState.jointId != INDEX_NONE) backend->ExecuteWrite([&]() { substepState.jointId = INDEX_NONE; });
+		backend->DestroyJoint(jointId);
+	}
+	substepState.jointId = INDEX_NONE;
+	jointId = INDEX_NONE;
 }
 
 void UVRPhysicsHandleComponent::ToggleDrive(bool linearDrive, bool angularDrive)
@@ -401,60 +454,17 @@ void UVRPhysicsHandleComponent::ResetJoint()
 
 void UVRPhysicsHandleComponent::ReinitJoint()
 {
- 	// Re-Initialise the constraints joint setup and drives.
- #if WITH_PHYSX
- 	if (joint != nullptr)
+ 	// Re-Initialise the constraints joint setup and drives. (Setup weather the constraint is soft or stiff)
+	IHandlePhysicsBackend* backend = GetBackend();
+ 	if (jointId != INDEX_NONE && backend)
  	{
- 		// Re-initialize the joint created when grabbed. (Setup weather the constraint is soft or stiff)
- 		PxD6Motion::Enum const LocationMotionType = handleData.softLinearConstraint ? PxD6Motion::eFREE : PxD6Motion::eLOCKED;
- 		PxD6Motion::Enum const RotationMotionType = (handleData.softAngularConstraint || !rotationConstraint) ? PxD6Motion::eFREE : PxD6Motion::eLOCKED;
- 
- 		// Linear motion for handle.
- 		joint->setMotion(PxD6Axis::eX, LocationMotionType);
- 		joint->setMotion(PxD6Axis::eY, LocationMotionType);
- 		joint->setMotion(PxD6Axis::eZ, LocationMotionType);
- 		joint->setDrivePosition(PxTransform(PxVec3(0, 0, 0)));
- 
- 		// Angular motion for the handle.
- 		joint->setMotion(PxD6Axis::eTWIST, RotationMotionType);
- 		joint->setMotion(PxD6Axis::eSWING1, RotationMotionType);
- 		joint->setMotion(PxD6Axis::eSWING2, RotationMotionType);
- 
- 		// Setup Linear drives for this physics handle if created.
- 		if (handleData.softLinearConstraint)
- 		{
- 			joint->setDrive(PxD6Drive::eX, PxD6JointDrive(handleData.linearStiffness, handleData.linearDamping, handleData.maxLinearForce, PxD6JointDriveFlag::eACCELERATION));
- 			joint->setDrive(PxD6Drive::eY, PxD6JointDrive(handleData.linearStiffness, handleData.linearDamping, handleData.maxLinearForce, PxD6JointDriveFlag::eACCELERATION));
- 			joint->setDrive(PxD6Drive::eZ, PxD6JointDrive(handleData.linearStiffness, handleData.linearDamping, handleData.maxLinearForce, PxD6JointDriveFlag::eACCELERATION));
- 		}
- 		// Reset linear drives.
- 		else
- 		{
- 			joint->setDrive(PxD6Drive::eX, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
- 			joint->setDrive(PxD6Drive::eY, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
- 			joint->setDrive(PxD6Drive::eZ, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
- 		}
- 
- 		// Setup Angular drives for this physics handle if created.
- 		if (rotationConstraint)
- 		{
- 			if (handleData.softAngularConstraint)
- 			{
- 				joint->setDrive(PxD6Drive::eSLERP, PxD6JointDrive(handleData.angularStiffness, handleData.angularDamping, handleData.maxAngularForce, PxD6JointDriveFlag::eACCELERATION));
- 			}
- 			// Reset angular drive.
- 			else
- 			{
- 				joint->setDrive(PxD6Drive::eSLERP, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
- 			}
- 		}
+		backend->SetupJoint(jointId, handleData, rotationConstraint);
  		
  #if WITH_EDITOR
  		// Log the new handle values.
  		if (debug) UE_LOG(LogVRHandle, Log, TEXT("\n \n %s \n"), *handleData.ToString());
  #endif // END Editor
  	}
- #endif // END PhysX
 }
 
 void UVRPhysicsHandleComponent::UpdateHandleTargetRotation(FRotator updatedRotation)
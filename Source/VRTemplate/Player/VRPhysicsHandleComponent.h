@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "Components/ActorComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "Globals.h"
 #include "VRPhysicsHandleComponent.generated.h"
 
@@ -11,12 +12,44 @@
 DECLARE_LOG_CATEGORY_EXTERN(LogVRHandle, Log, All);
 
 /** Declare classes used within this H file. */
-namespace physx
-{
-	class PxD6Joint;
-	class PxRigidDynamic;
-}
 class UPrimitiveComponent;
+class APhysicsHandleManager;
+class IHandlePhysicsBackend;
+
+/** How the kinematic target is moved when physics is substepped. */
+UENUM(BlueprintType)
+enum class EHandleSubstepMode : uint8
+{
+	Disabled UMETA(DisplayName = "Disabled", ToolTip = "Move the target once per frame, the joint chases a target that jumps once per frame when substepping."),
+	Interpolate UMETA(DisplayName = "Interpolate", ToolTip = "Move the target each substep from last frames target to this frames target. Smooth but a frame behind."),
+	Extrapolate UMETA(DisplayName = "Extrapolate", ToolTip = "Move the target each substep ahead of this frames target along the targets velocity. Smooth without the latency but can overshoot on sudden stops."),
+};
+
+/** Copy of the targets motion over a frame made when the substeps are queued, so the physics thread never reads the handles game thread state. */
+struct FHandleSubstepState
+{
+	IHandlePhysicsBackend* backend; /** The backend the joint was created with. */
+	int32 jointId; /** Id of the joint to move, cleared under the scene lock when the joint is released. */
+	EHandleSubstepMode mode; /** How the target is moved each substep. */
+	FTransform startTransform; /** Target transform at the end of last frame, where the substeps start from. */
+	FTransform endTransform; /** Target transform at the end of this frame. */
+	FVector linearVelocity; /** Velocity of the target over the frame. */
+	FVector angularVelocity; /** Angular velocity of the target over the frame, as an axis scaled by radians per second. */
+	float frameTime; /** Delta time of the frame the substeps are for. */
+	float time; /** Time into the frame of the last substep, only changed by the substeps. */
+
+	/** Constructor. */
+	FHandleSubstepState()
+	{
+		backend = nullptr;
+		jointId = INDEX_NONE;
+		mode = EHandleSubstepMode::Disabled;
+		linearVelocity = FVector::ZeroVector;
+		angularVelocity = FVector::ZeroVector;
+		frameTime = 0.0f;
+		time = 0.0f;
+	}
+};
 
 /** VR Physics Handle data, holds all of this classes functionality variables. Defaults values are tested with 1kg grabbable assets. 
  * NOTE: Values may need to be higher to have effect on lighter components less than 1KG and heavier may need weaker values to prevent collision issues.
@@ -49,7 +82,8 @@ public:
 	/** The max amount of force the angular drive of the joint can apply. NOTE: Only used if the soft angular constraint is enabled. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PhysicsHandle", meta = (EditCondition = "handleDataEnabled"))
 		float maxAngularForce;
-	/** The interpolation speed of the current target location to the new target location. NOTE: Only used if the interpolation is enabled. */
+	/** The interpolation speed of the current target location to the new target location, the gap shrinks by a factor of e every 1/interpSpeed seconds
+	 * whatever the frame rate. NOTE: Only used if the interpolation is enabled. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PhysicsHandle", meta = (EditCondition = "handleDataEnabled"))
 		float interpSpeed;
 	/** Should use soft angular constraint on the joint for this handle. NOTE: Changes angular constraint to be free and targets angular rotation with the angular drive of the joint. */
@@ -155,6 +189,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PhysicsHandle")
 	bool debug;
 
+	/** Update this handle from the worlds physics handle manager along with every other handle, so all kinematic targets are moved under one
+	 * physics scene lock. Disables this components tick. If false this handle ticks and locks the scene itself.
+	 * NOTE: Only read on begin play. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PhysicsHandle")
+	bool batchedUpdate;
+
+	/** How the kinematic target is moved during each physics substep, allows the game thread to run slower than physics without grabbed
+	 * objects jittering. NOTE: Only has an effect while the worlds physics scene is substepping and the physics backend supports it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PhysicsHandle")
+	EHandleSubstepMode substepMode;
+
 	/** Pointer to the tracked component so the positions can be updated within this class. */
 	UPROPERTY(BlueprintReadOnly, Category = "Physics")
 	UPrimitiveComponent* targetComponent;
@@ -170,6 +215,33 @@ public:
 	/** Frame. Start of physics. */
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/** Update the target transform from the target component and move the current transform towards it. Ran from tick or the handle manager.
+	 * @Param DeltaTime, The frame delta time used to interpolate to the target. */
+	void UpdateTarget(float DeltaTime);
+
+	/** Move the kinematic target actor to the given transform if it has changed enough.
+	 * NOTE: The physics scene must already be write locked, use UpdateHandleTransform otherwise.
+	 * @Param updatedTransform, The new updated location/rotation for the transform. */
+	void ApplyHandleTransform_AssumesLocked(const FTransform& updatedTransform);
+
+	/** Move a joints kinematic target to the given transform if it has changed enough. Safe to call from the physics thread.
+	 * NOTE: The physics scene must already be write locked.
+	 * @Param backend, The backend the joint was created with.
+	 * @Param joint, The id of the joint.
+	 * @Param updatedTransform, The new updated location/rotation for the transform. */
+	static void MoveTarget_AssumesLocked(IHandlePhysicsBackend* backend, int32 joint, const FTransform& updatedTransform);
+
+	/** Fraction of the gap to the target to close over a frame with exponential smoothing.
+	 * @Param speed, Smoothing speed, the gap shrinks by a factor of e every 1/speed seconds. Negative to snap to the target.
+	 * @Param deltaTime, The frame delta time. */
+	static float GetSmoothingAlpha(float speed, float deltaTime);
+
+	/** @Return true if a joint has been created and has a target to move. */
+	FORCEINLINE bool IsJointActive() const { return jointId != INDEX_NONE; }
+
+	/** @Return true if the kinematic target is moved in each physics substep instead of once per frame, only when the physics scene is substepping. */
+	bool UsingSubsteps() const;
+
 	// BP //
 	/** Create a joint between the physics handle and the given component. Requires SetTargetLocation to be ran to update the current joints location...
 	 * NOTE: Equivalent of normal physics handles GrabComponentAtLocation function.
@@ -314,11 +386,13 @@ public:
 
 protected:
 
-	physx::PxD6Joint* joint; /** Pointer to PhysX joint created when a component is grabbed. */
-	physx::PxRigidDynamic* targetActor; /** Pointer to target actor created in the create joint function to constrain a given component to. */
+	int32 jointId; /** Id of the backend joint created when a component is grabbed, INDEX_NONE if there is none. */
 	FTransform targetOffset; /** Relative offset transform from the target component that the constraint was initialized / positioned. */
 	bool rotationConstraint; /** Is the rotation constraint currently active. */
 	FPhysicsHandleData originalData; /** Original physics handle data of this class, in case its replaced on creating the constraint. */
+	TWeakObjectPtr<APhysicsHandleManager> manager; /** The manager owning the backend of this handles joint, also updates this handle if batchedUpdate is enabled. */
+	FCalculateCustomPhysics onCalculateCustomPhysics; /** Called in each physics substep when using a substep mode. */
+	FHandleSubstepState substepState; /** The targets motion over this frame, written when queuing the substeps and only read by them. */
 
 	/** Unregister this component. */
 	void OnUnregister();
@@ -327,7 +401,7 @@ protected:
 	virtual void BeginPlay() override;
 	
 	/** Function to create a  physics target actor and a joint between itself and the given component.
-	 * NOTE: The targetActors location must be updated to move the constraint. Also ONLY use CreateJointAndFollowLocation OR CreateJointAndFollowLocationWithRotation.
+	 * NOTE: The targets location must be updated to move the constraint. Also ONLY use CreateJointAndFollowLocation OR CreateJointAndFollowLocationWithRotation.
 	 * @Param comp, The component to be constrained to the handle location & rotation.
 	 * @Param target, The target component to be followed relative to the grabLocation.
 	 * @Param boneName, The bone of given component to be constrained.
@@ -338,6 +412,22 @@ protected:
 	void CreateJoint(UPrimitiveComponent* comp, UPrimitiveComponent* target, FName boneName, const FVector& grabLocation, const FRotator& grabOrientation,
 		bool constrainRotation = false, FPhysicsHandleData interactableData = FPhysicsHandleData());
 
+	/** Record the targets motion over this frame and queue the substep callback on the grabbed body.
+	 * @Param DeltaTime, The frame delta time.
+	 * @Param lastTransform, The target transform at the end of the last frame. */
+	void QueueSubsteps(float DeltaTime, const FTransform& lastTransform);
+
+	/** Called from the physics scene before each substep to move the kinematic target from the queued substep state. The scene is locked.
+	 * @Param DeltaTime, The substeps delta time.
+	 * @Param bodyInstance, The grabbed body the callback was added to. */
+	void SubstepTick(float DeltaTime, FBodyInstance* bodyInstance);
+
+	/** @Return the physics backend to create and move the joint with, null if the manager has gone. */
+	IHandlePhysicsBackend* GetBackend() const;
+
+	/** Destroy the joint through the backend and clear it. */
+	void ReleaseJoint();
+
 	/** Update the transform transform of the joint if one currently exists.
 	 * @Param updatedTransform, The new updated location/rotation for the transform. */
 	void UpdateHandleTransform(const FTransform& updatedTransform);
@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/ArcMeshBuilder.h"
+
+FArcMeshBuilder::FArcMeshBuilder()
+{
+	numRings = 24;
+	numSides = 6;
+	radius = 1.0f;
+}
+
+int32 FArcMeshBuilder::GetNumVertices() const
+{
+	// Each ring repeats its first vertex so the UVs can wrap.
+	return FMath::Max(numRings, 2) * (FMath::Max(numSides, 3) + 1);
+}
+
+void FArcMeshBuilder::BuildTriangles(FArcMeshData& data) const
+{
+	const int32 rings = FMath::Max(numRings, 2);
+	const int32 sides = FMath::Max(numSides, 3);
+	const int32 ringVertices = sides + 1;
+	data.triangles.SetNumUninitialized((rings - 1) * sides * 6);
+
+	// Two triangles for each quad between neighbouring rings, wound to face out of the tube.
+	int32 index = 0;
+	for (int32 ring = 0; ring < rings - 1; ring++)
+	{
+		for (int32 side = 0; side < sides; side++)
+		{
+			const int32 a = ring * ringVertices + side;
+			const int32 b = a + 1;
+			const int32 c = a + ringVertices;
+			const int32 d = c + 1;
+			data.triangles[index++] = a;
+			data.triangles[index++] = b;
+			data.triangles[index++] = c;
+			data.triangles[index++] = b;
+			data.triangles[index++] = d;
+			data.triangles[index++] = c;
+		}
+	}
+}
+
+bool FArcMeshBuilder::BuildVertices(const TArray<FVector>& points, FArcMeshData& data) const
+{
+	const int32 rings = FMath::Max(numRings, 2);
+	const int32 sides = FMath::Max(numSides, 3);
+	const float length = Resample(points, rings, data.ringCenters);
+	if (length <= KINDA_SMALL_NUMBER) return false;
+
+	const int32 numVertices = GetNumVertices();
+	data.vertices.SetNumUninitialized(numVertices);
+	data.normals.SetNumUninitialized(numVertices);
+	data.uvs.SetNumUninitialized(numVertices);
+
+	// Start with any normal perpendicular to the first tangent.
+	FVector lastTangent = (data.ringCenters[1] - data.ringCenters[0]).GetSafeNormal();
+	const FVector up = FMath::Abs(lastTangent.Z) < 0.99f ? FVector::UpVector : FVector::ForwardVector;
+	FVector normal = (lastTangent ^ up).GetSafeNormal();
+
+	int32 index = 0;
+	for (int32 ring = 0; ring < rings; ring++)
+	{
+		// Tangent from the neighbouring rings, one sided at the ends.
+		const FVector& previous = data.ringCenters[FMath::Max(ring - 1, 0)];
+		const FVector& next = data.ringCenters[FMath::Min(ring + 1, rings - 1)];
+		const FVector tangent = (next - previous).GetSafeNormal();
+
+		// Carry the normal along by the change in tangent so the rings don't twist.
+		normal = FQuat::FindBetweenNormals(lastTangent, tangent).RotateVector(normal);
+		normal = (normal - tangent * (normal | tangent)).GetSafeNormal();
+		const FVector binormal = tangent ^ normal;
+		lastTangent = tangent;
+
+		// Place the ring of vertices around the center.
+		const float v = (float)ring / (rings - 1);
+		for (int32 side = 0; side <= sides; side++)
+		{
+			const float u = (float)side / sides;
+			float sin, cos;
+			FMath::SinCos(&sin, &cos, u * 2.0f * PI);
+			const FVector direction = normal * cos + binormal * sin;
+			data.vertices[index] = data.ringCenters[ring] + direction * radius;
+			data.normals[index] = direction;
+			data.uvs[index] = FVector2D(u, v);
+			index++;
+		}
+	}
+	return true;
+}
+
+float FArcMeshBuilder::Resample(const TArray<FVector>& points, int32 count, TArray<FVector>& outPoints)
+{
+	count = FMath::Max(count, 2);
+	outPoints.SetNumUninitialized(count);
+
+	// Total length of the path.
+	float length = 0.0f;
+	for (int32 i = 1; i < points.Num(); i++) length += FVector::Dist(points[i - 1], points[i]);
+	if (length <= KINDA_SMALL_NUMBER)
+	{
+		const FVector point = points.Num() > 0 ? points[0] : FVector::ZeroVector;
+		for (int32 i = 0; i < count; i++) outPoints[i] = point;
+		return 0.0f;
+	}
+
+	// Walk along the path placing each output point at its distance.
+	int32 segment = 1;
+	float segmentStart = 0.0f;
+	float segmentLength = FVector::Dist(points[0], points[1]);
+	for (int32 i = 0; i < count; i++)
+	{
+		const float distance = length * i / (count - 1);
+		while (segment < points.Num() - 1 && segmentStart + segmentLength < distance)
+		{
+			segmentStart += segmentLength;
+			segment++;
+			segmentLength = FVector::Dist(points[segment - 1], points[segment]);
+		}
+		const float alpha = segmentLength > KINDA_SMALL_NUMBER ? FMath::Clamp((distance - segmentStart) / segmentLength, 0.0f, 1.0f) : 1.0f;
+		outPoints[i] = FMath::Lerp(points[segment - 1], points[segment], alpha);
+	}
+	return length;
+}
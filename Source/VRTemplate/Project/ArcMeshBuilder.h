@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** Vertex and index data for a built arc mesh. Arrays are kept between builds so rebuilding doesn't allocate. */
+struct FArcMeshData
+{
+	TArray<FVector> vertices; /** Vertex positions. */
+	TArray<FVector> normals; /** Vertex normals. */
+	TArray<FVector2D> uvs; /** Vertex UVs, U around the tube and V along its length. */
+	TArray<int32> triangles; /** Triangle indices, only depend on the ring and side counts. */
+	TArray<FVector> ringCenters; /** Resampled path the rings are placed along. */
+};
+
+/** Builds a tube mesh along a path of points, used to draw the teleport arc as a single mesh instead of a component per segment.
+ * The path is resampled to a fixed number of rings so the vertex and index counts never change, meaning after the first build only
+ * the vertex buffer needs updating. Rings are oriented with a parallel transport frame so the tube doesn't twist along the arc. */
+class VRTEMPLATE_API FArcMeshBuilder
+{
+public:
+
+	/** Number of rings of vertices along the tube. */
+	int32 numRings;
+
+	/** Number of sides around the tube. */
+	int32 numSides;
+
+	/** Radius of the tube. */
+	float radius;
+
+public:
+
+	/** Constructor. */
+	FArcMeshBuilder();
+
+	/** @Return the number of vertices in a built mesh. */
+	int32 GetNumVertices() const;
+
+	/** Build the triangle indices for the current ring and side counts.
+	 * @Param data, The mesh data to fill the triangles of. */
+	void BuildTriangles(FArcMeshData& data) const;
+
+	/** Build the vertices, normals and UVs of the tube along the path.
+	 * @Param points, The path to build along, in the space the mesh is drawn in.
+	 * @Param data, The mesh data to fill the vertices of.
+	 * @Return false if the path has no length, data is left unchanged. */
+	bool BuildVertices(const TArray<FVector>& points, FArcMeshData& data) const;
+
+	/** Resample a path to points evenly spaced along its length.
+	 * @Param points, The path to resample.
+	 * @Param count, Number of points to output, at least 2.
+	 * @Param outPoints, The resampled points.
+	 * @Return the length of the path. */
+	static float Resample(const TArray<FVector>& points, int32 count, TArray<FVector>& outPoints);
+};
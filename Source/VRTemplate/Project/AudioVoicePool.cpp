@@ -0,0 +1,287 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/AudioVoicePool.h"
+#include "Project/WorldService.h"
+#include "Components/AudioComponent.h"
+#include "Components/SceneComponent.h"
+#include "Sound/SoundBase.h"
+#include "Sound/SoundAttenuation.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+DEFINE_LOG_CATEGORY(LogAudioVoicePool);
+
+AAudioVoicePool::AAudioVoicePool()
+{
+	// Start the frames sounds after everything else has requested them.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+
+	// Root to hold the voices that are not attached to anything.
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// Initialise default variables.
+	maxVoices = 16;
+	startBudget = 4;
+	cullDistance = 4000.0f;
+	listenerLocation = FVector::ZeroVector;
+	listenerFrame = 0;
+	hasListener = false;
+	nextRequestID = 1;
+
+#if WITH_EDITOR
+	debug = false;
+#endif
+}
+
+void AAudioVoicePool::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Create the voices.
+	BuildPool();
+
+	// Find the listener now so sounds played before the first tick are culled from the right location.
+	UpdateListenerLocation();
+}
+
+AAudioVoicePool* AAudioVoicePool::Get(UWorld* world)
+{
+	CHECK_RETURN_NULL(LogAudioVoicePool, !world, "AAudioVoicePool::Get: Cannot get the voice pool of a null world.");
+
+	// Find or spawn the pool.
+	AAudioVoicePool* pool = GetWorldService<AAudioVoicePool>(world);
+	CHECK_RETURN_NULL(LogAudioVoicePool, !pool, "AAudioVoicePool::Get: Failed to spawn the voice pool.");
+	return pool;
+}
+
+void AAudioVoicePool::BuildPool()
+{
+	voices.Reserve(maxVoices);
+	voiceStates.Reserve(maxVoices);
+	pendingSounds.Reserve(maxVoices);
+
+	// Create and register each voice up front so no audio components are created while playing.
+	for (int i = 0; i < maxVoices; i++)
+	{
+		UAudioComponent* voice = NewObject<UAudioComponent>(this, *FString::Printf(TEXT("Voice_%d"), i));
+		voice->bAutoActivate = false;
+		voice->bAutoDestroy = false;
+		voice->bStopWhenOwnerDestroyed = true;
+		voice->SetupAttachment(RootComponent);
+		voice->RegisterComponent();
+		voices.Add(voice);
+
+		FVoiceState state;
+		state.requestID = 0;
+		state.score = 0.0f;
+		voiceStates.Add(state);
+	}
+}
+
+float AAudioVoicePool::ScoreSound(EAudioVoicePriority priority, float volume, float distance) const
+{
+	// Priority always comes first, then louder and closer sounds.
+	float distanceAlpha = 1.0f - FMath::Clamp(distance / cullDistance, 0.0f, 1.0f);
+	return (float)priority * 10.0f + FMath::Clamp(volume, 0.0f, 2.0f) * distanceAlpha;
+}
+
+void AAudioVoicePool::UpdateListenerLocation()
+{
+	RETURN(listenerFrame == GFrameCounter && hasListener);
+	if (APlayerController* controller = GetWorld()->GetFirstPlayerController())
+	{
+		FVector frontDir, rightDir;
+		controller->GetAudioListenerPosition(listenerLocation, frontDir, rightDir);
+		listenerFrame = GFrameCounter;
+		hasListener = true;
+	}
+}
+
+float AAudioVoicePool::GetMaxDistance(USoundBase* sound, USoundAttenuation* attenuation)
+{
+	// Same as USoundBase::GetMaxDistance but with the override.
+	if (attenuation) return attenuation->Attenuation.bAttenuate ? attenuation->Attenuation.GetMaxDimension() : WORLD_MAX;
+	return sound->GetMaxDistance();
+}
+
+FAudioVoiceHandle AAudioVoicePool::PlaySound(USoundBase* sound, FVector location, float volume, float pitch, EAudioVoicePriority priority, USceneComponent* attachTo, USoundAttenuation* attenuation)
+{
+	FAudioVoiceHandle handle;
+	if (!sound) return handle;
+	if (attachTo) location = attachTo->GetComponentLocation();
+
+	// Cull sounds that are too far away to be heard.
+	UpdateListenerLocation();
+	float distance = hasListener ? FVector::Dist(location, listenerLocation) : 0.0f;
+	if (distance > FMath::Min(cullDistance, GetMaxDistance(sound, attenuation)))
+	{
+		stats.culled++;
+		return handle;
+	}
+
+	// Add to the pending sounds to be started at the end of the frame.
+	FPendingSound pending;
+	pending.sound = sound;
+	pending.attenuation = attenuation;
+	pending.attachTo = attachTo;
+	pending.location = location;
+	pending.volume = volume;
+	pending.pitch = pitch;
+	pending.priority = priority;
+	pending.score = ScoreSound(priority, volume, distance);
+	pending.requestID = nextRequestID++;
+	if (nextRequestID == 0) nextRequestID = 1;
+	pendingSounds.Add(pending);
+
+	handle.requestID = pending.requestID;
+	return handle;
+}
+
+void AAudioVoicePool::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Keep the listener up to date even on frames nothing is played.
+	UpdateListenerLocation();
+	RETURN(pendingSounds.Num() == 0);
+
+	// Start the most important sounds first.
+	pendingSounds.Sort([](const FPendingSound& a, const FPendingSound& b) { return a.score > b.score; });
+
+	int startedThisFrame = 0;
+	int deferred = 0;
+	for (int i = 0; i < pendingSounds.Num(); i++)
+	{
+		const FPendingSound& pending = pendingSounds[i];
+
+		// Over budget, defer high priority sounds to the next frame and drop the rest.
+		if (startedThisFrame >= startBudget)
+		{
+			if (pending.priority == EAudioVoicePriority::High) pendingSounds[deferred++] = pending;
+			else stats.dropped++;
+			continue;
+		}
+
+		// Find a free voice, otherwise the lowest scoring voice to steal.
+		int32 freeVoice = INDEX_NONE;
+		int32 weakestVoice = INDEX_NONE;
+		for (int32 v = 0; v < voices.Num(); v++)
+		{
+			if (!voices[v]->IsPlaying())
+			{
+				freeVoice = v;
+				break;
+			}
+			if (weakestVoice == INDEX_NONE || voiceStates[v].score < voiceStates[weakestVoice].score) weakestVoice = v;
+		}
+
+		if (freeVoice == INDEX_NONE)
+		{
+			// Only steal voices playing less important sounds.
+			if (weakestVoice == INDEX_NONE || voiceStates[weakestVoice].score >= pending.score)
+			{
+				stats.dropped++;
+				continue;
+			}
+			voices[weakestVoice]->Stop();
+			freeVoice = weakestVoice;
+			stats.stolen++;
+		}
+
+		StartVoice(freeVoice, pending);
+		startedThisFrame++;
+	}
+	pendingSounds.SetNum(deferred, false);
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug) UE_LOG(LogAudioVoicePool, Log, TEXT("Started %d sounds, %d deferred. Totals: started %d, stolen %d, culled %d, dropped %d."),
+		startedThisFrame, deferred, stats.started, stats.stolen, stats.culled, stats.dropped);
+#endif
+}
+
+void AAudioVoicePool::StartVoice(int32 voiceIndex, const FPendingSound& pending)
+{
+	UAudioComponent* voice = voices[voiceIndex];
+
+	// Follow the given component or play at the requested location.
+	if (USceneComponent* attachTo = pending.attachTo.Get())
+	{
+		voice->AttachToComponent(attachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	}
+	else
+	{
+		if (voice->GetAttachParent() != RootComponent) voice->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepWorldTransform);
+		voice->SetWorldLocation(pending.location);
+	}
+
+	// Setup and play the sound.
+	voice->AttenuationSettings = pending.attenuation;
+	voice->SetSound(pending.sound);
+	voice->SetVolumeMultiplier(pending.volume);
+	voice->SetPitchMultiplier(pending.pitch);
+	voice->Play();
+
+	voiceStates[voiceIndex].requestID = pending.requestID;
+	voiceStates[voiceIndex].score = pending.score;
+	stats.started++;
+}
+
+bool AAudioVoicePool::IsPlaying(const FAudioVoiceHandle& handle) const
+{
+	if (!handle.IsValid()) return false;
+
+	// Still waiting to start.
+	for (const FPendingSound& pending : pendingSounds)
+	{
+		if (pending.requestID == handle.requestID) return true;
+	}
+
+	// Playing on a voice.
+	for (int32 v = 0; v < voices.Num(); v++)
+	{
+		if (voiceStates[v].requestID == handle.requestID) return voices[v]->IsPlaying();
+	}
+	return false;
+}
+
+void AAudioVoicePool::Stop(const FAudioVoiceHandle& handle, float fadeTime)
+{
+	RETURN(!handle.IsValid());
+
+	// Remove if still waiting to start.
+	for (int32 i = 0; i < pendingSounds.Num(); i++)
+	{
+		if (pendingSounds[i].requestID == handle.requestID)
+		{
+			pendingSounds.RemoveAt(i, 1, false);
+			return;
+		}
+	}
+
+	// Otherwise stop the voice playing it.
+	for (int32 v = 0; v < voices.Num(); v++)
+	{
+		if (voiceStates[v].requestID == handle.requestID)
+		{
+			if (fadeTime > 0.0f) voices[v]->FadeOut(fadeTime, 0.0f);
+			else voices[v]->Stop();
+			return;
+		}
+	}
+}
+
+FAudioVoiceHandle AAudioVoicePool::PlaySoundAtLocation(const UObject* worldContextObject, USoundBase* sound, FVector location, float volume, float pitch, EAudioVoicePriority priority, USoundAttenuation* attenuation)
+{
+	UWorld* world = GEngine->GetWorldFromContextObject(worldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (AAudioVoicePool* pool = AAudioVoicePool::Get(world))
+	{
+		return pool->PlaySound(sound, location, volume, pitch, priority, nullptr, attenuation);
+	}
+
+	// No pool, play the sound as normal.
+	UGameplayStatics::PlaySoundAtLocation(worldContextObject, sound, location, volume, pitch, 0.0f, attenuation);
+	return FAudioVoiceHandle();
+}
@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Globals.h"
+#include "AudioVoicePool.generated.h"
+
+/** Define this actors log category. */
+DECLARE_LOG_CATEGORY_EXTERN(LogAudioVoicePool, Log, All);
+
+/** Declare classes used. */
+class UAudioComponent;
+class USoundBase;
+class USoundAttenuation;
+class USceneComponent;
+
+/** Priority of a pooled sound, higher priorities are started first and can steal voices from lower ones. */
+UENUM(BlueprintType)
+enum class EAudioVoicePriority : uint8
+{
+	Low UMETA(DisplayName = "Low", ToolTip = "Ambient or repeated sounds that can be dropped, impacts from piles of physics objects etc."),
+	Normal UMETA(DisplayName = "Normal", ToolTip = "Default sounds, hand impacts, sliding and rotating impacts etc."),
+	High UMETA(DisplayName = "High", ToolTip = "Important sounds that should always be heard, buttons, locks, teleporting etc."),
+};
+
+/** Handle to a sound requested from the voice pool, can be used to check if it is playing or stop it. */
+struct FAudioVoiceHandle
+{
+	uint32 requestID; /** Unique ID of the request, 0 is invalid. */
+
+	FAudioVoiceHandle()
+	{
+		requestID = 0;
+	}
+
+	/** Was the sound accepted by the pool. */
+	bool IsValid() const { return requestID != 0; }
+};
+
+/** Counters for how the voice pool is handling requests. */
+USTRUCT(BlueprintType)
+struct FAudioVoicePoolStats
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Sounds started on a voice. */
+	UPROPERTY(BlueprintReadOnly, Category = "Audio")
+	int started;
+
+	/** Sounds that stopped a lower priority voice to play. */
+	UPROPERTY(BlueprintReadOnly, Category = "Audio")
+	int stolen;
+
+	/** Sounds ignored for being too far from the listener. */
+	UPROPERTY(BlueprintReadOnly, Category = "Audio")
+	int culled;
+
+	/** Sounds dropped for being over the start budget or having no voice to steal. */
+	UPROPERTY(BlueprintReadOnly, Category = "Audio")
+	int dropped;
+
+	/** Default constructor. */
+	FAudioVoicePoolStats()
+	{
+		started = 0;
+		stolen = 0;
+		culled = 0;
+		dropped = 0;
+	}
+};
+
+/** World level pool of pre-registered audio components used for all one shot sounds from the hands and interactables.
+ * Requests are collected during the frame and started at the end of it in order of priority, volume and distance, up to a per frame
+ * start budget. When every voice is busy the lowest scoring playing voice is stolen if the new sound is more important.
+ * NOTE: Spawned on demand through Get(), there should only ever be one per world. Looping sounds owned by an interactable still use their own audio component. */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class VRTEMPLATE_API AAudioVoicePool : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Number of audio components in the pool, the max amount of pooled sounds that can play at once. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AudioPool")
+	int maxVoices;
+
+	/** Max number of sounds started per frame. Sounds over budget are dropped unless they are high priority which are deferred to the next frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AudioPool")
+	int startBudget;
+
+	/** Sounds requested further than this distance from the listener are culled. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AudioPool")
+	float cullDistance;
+
+	/** Enable any debug messages for this class.
+	 * NOTE: Only used when DEVELOPMENT = 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AudioPool")
+	bool debug;
+
+protected:
+
+	/** Pooled audio components. */
+	UPROPERTY()
+	TArray<UAudioComponent*> voices;
+
+	/** Level start. */
+	virtual void BeginPlay() override;
+
+private:
+
+	/** A sound waiting to be started at the end of the frame. */
+	struct FPendingSound
+	{
+		USoundBase* sound;
+		USoundAttenuation* attenuation;
+		TWeakObjectPtr<USceneComponent> attachTo;
+		FVector location;
+		float volume, pitch, score;
+		EAudioVoicePriority priority;
+		uint32 requestID;
+	};
+
+	/** State of each voice in the pool. */
+	struct FVoiceState
+	{
+		uint32 requestID; /** The request currently playing on this voice. */
+		float score; /** Score of the playing request used for stealing. */
+	};
+
+	TArray<FPendingSound> pendingSounds; /** Sounds requested this frame. */
+	TArray<FVoiceState> voiceStates; /** State of each voice, same order as the voices array. */
+	FAudioVoicePoolStats stats; /** Counters. */
+	FVector listenerLocation; /** Listener location, updated once per frame. */
+	uint64 listenerFrame; /** Frame the listener location was last updated. */
+	bool hasListener; /** Has a listener been found yet, nothing is culled until there is one. */
+	uint32 nextRequestID; /** Next request ID to hand out. */
+
+private:
+
+	/** Create the pooled audio components. */
+	void BuildPool();
+
+	/** Start the sound on the given voice. */
+	void StartVoice(int32 voiceIndex, const FPendingSound& pending);
+
+	/** Score a request for sorting and stealing, higher is more important. */
+	float ScoreSound(EAudioVoicePriority priority, float volume, float distance) const;
+
+	/** Update the listener location from the first player controller if it hasn't been already this frame. */
+	void UpdateListenerLocation();
+
+	/** @Return the distance the sound can be heard from, using the attenuation override if one is given. */
+	static float GetMaxDistance(USoundBase* sound, USoundAttenuation* attenuation);
+
+public:
+
+	/** Constructor. */
+	AAudioVoicePool();
+
+	/** Starts pending sounds at the end of the frame. */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Get the voice pool for the given world, spawning one if it doesn't exist yet.
+	 * @Param world, The world to get the pool for. */
+	static AAudioVoicePool* Get(UWorld* world);
+
+	/** Request a sound from the pool. It will be started at the end of the frame if it is within budget and a voice is available.
+	 * @Param sound, The sound to play.
+	 * @Param location, World location to play the sound at, ignored if attachTo is valid.
+	 * @Param volume, The volume to play the sound at.
+	 * @Param pitch, The pitch to play the sound at.
+	 * @Param priority, The priority of this sound.
+	 * @Param attachTo, Optional component for the sound to follow while playing.
+	 * @Param attenuation, Optional attenuation override.
+	 * @Return Handle to the sound, invalid if it was culled. */
+	FAudioVoiceHandle PlaySound(USoundBase* sound, FVector location, float volume = 1.0f, float pitch = 1.0f, EAudioVoicePriority priority = EAudioVoicePriority::Normal,
+		USceneComponent* attachTo = nullptr, USoundAttenuation* attenuation = nullptr);
+
+	/** @Return true if the sound for the given handle is waiting to start or still playing. */
+	bool IsPlaying(const FAudioVoiceHandle& handle) const;
+
+	/** Stop the sound for the given handle.
+	 * @Param handle, The sound to stop.
+	 * @Param fadeTime, Time to fade the sound out over, stops instantly if 0. */
+	void Stop(const FAudioVoiceHandle& handle, float fadeTime = 0.0f);
+
+	/** Play a one shot sound through the worlds voice pool, falls back to UGameplayStatics::PlaySoundAtLocation if there is no pool.
+	 * NOTE: Drop in replacement for UGameplayStatics::PlaySoundAtLocation in the hands and interactables. */
+	static FAudioVoiceHandle PlaySoundAtLocation(const UObject* worldContextObject, USoundBase* sound, FVector location, float volume = 1.0f, float pitch = 1.0f,
+		EAudioVoicePriority priority = EAudioVoicePriority::Normal, USoundAttenuation* attenuation = nullptr);
+
+	/** @Return the counters for this pool. */
+	UFUNCTION(BlueprintCallable, Category = "AudioPool")
+	FAudioVoicePoolStats GetStats() const { return stats; }
+};
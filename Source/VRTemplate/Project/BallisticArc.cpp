@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/BallisticArc.h"
+
+FBallisticArc::FBallisticArc()
+{
+	start = FVector::ZeroVector;
+	velocity = FVector::ZeroVector;
+	gravity = 0.0f;
+}
+
+FBallisticArc::FBallisticArc(const FVector& startLocation, const FVector& launchVelocity, float gravityZ)
+{
+	start = startLocation;
+	velocity = launchVelocity;
+	gravity = gravityZ;
+}
+
+FVector FBallisticArc::GetLocation(float time) const
+{
+	return start + velocity * time + FVector(0.0f, 0.0f, 0.5f * gravity * time * time);
+}
+
+float FBallisticArc::GetChordError(float stepTime) const
+{
+	// The furthest a parabola gets from a chord is at the middle of it, a quarter of the change in height due to gravity over the chord.
+	return FMath::Abs(gravity) * stepTime * stepTime * 0.125f;
+}
+
+void FBallisticArc::GetPoints(float endTime, float stepTime, TArray<FVector>& outPoints) const
+{
+	outPoints.Reset();
+	if (stepTime <= SMALL_NUMBER) stepTime = FMath::Max(endTime, SMALL_NUMBER);
+
+	// Points at each step, skipping the last if it would be too close to the end point.
+	const int32 numSteps = FMath::Max(FMath::CeilToInt(endTime / stepTime), 1);
+	for (int32 i = 0; i < numSteps; i++)
+	{
+		outPoints.Add(GetLocation(stepTime * i));
+	}
+	outPoints.Add(GetLocation(endTime));
+}
+
+bool FBallisticArc::IsNearlyEqual(const FBallisticArc& other, float locationTolerance, float angleTolerance) const
+{
+	const float speed = velocity.Size();
+	if (gravity != other.gravity || !FMath::IsNearlyEqual(speed, other.velocity.Size(), speed * 0.001f)) return false;
+	if (FVector::DistSquared(start, other.start) > locationTolerance * locationTolerance) return false;
+	return (velocity.GetSafeNormal() | other.velocity.GetSafeNormal()) >= FMath::Cos(FMath::DegreesToRadians(angleTolerance));
+}
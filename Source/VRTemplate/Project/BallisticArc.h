@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** Analytic path of a projectile under constant gravity, used to trace the teleport arc in a few long segments instead of many short ones.
+ * Any segment of the arc stays within GetChordError of the straight line between its ends, so sweeping that line with a sphere of the
+ * chord error is guaranteed to touch anything the arc itself would hit. */
+class VRTEMPLATE_API FBallisticArc
+{
+public:
+
+	/** Start location. */
+	FVector start;
+
+	/** Launch velocity. */
+	FVector velocity;
+
+	/** Acceleration along the Z axis, negative is down. */
+	float gravity;
+
+public:
+
+	/** Constructor. */
+	FBallisticArc();
+
+	/** Constructor.
+	 * @Param startLocation, Start location.
+	 * @Param launchVelocity, Launch velocity.
+	 * @Param gravityZ, Acceleration along the Z axis. */
+	FBallisticArc(const FVector& startLocation, const FVector& launchVelocity, float gravityZ);
+
+	/** @Return the location along the arc at the given time. */
+	FVector GetLocation(float time) const;
+
+	/** @Return the max distance the arc can be from the straight line between two points on it the given time apart. */
+	float GetChordError(float stepTime) const;
+
+	/** Add points along the arc at a fixed time step, with a final point at the end time.
+	 * @Param endTime, Time of the last point.
+	 * @Param stepTime, Time between points.
+	 * @Param outPoints, Emptied and filled with the points. */
+	void GetPoints(float endTime, float stepTime, TArray<FVector>& outPoints) const;
+
+	/** @Return true if the start and launch direction of the other arc are within the tolerances of this one, and the speed and gravity are equal.
+	 * @Param other, Arc to compare against.
+	 * @Param locationTolerance, Max distance between the start locations.
+	 * @Param angleTolerance, Max angle in degrees between the launch directions. */
+	bool IsNearlyEqual(const FBallisticArc& other, float locationTolerance, float angleTolerance) const;
+};
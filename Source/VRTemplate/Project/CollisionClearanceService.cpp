@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/CollisionClearanceService.h"
+#include "Project/WorldService.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY(LogCollisionClearance);
+
+ACollisionClearanceService::ACollisionClearanceService()
+{
+	// Check after physics so the blockers positions are up to date.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	// Initialise default variables.
+	fullQueryInterval = 0.1f;
+
+#if WITH_EDITOR
+	debug = false;
+#endif
+}
+
+ACollisionClearanceService* ACollisionClearanceService::Get(UWorld* world)
+{
+	CHECK_RETURN_NULL(LogCollisionClearance, !world, "ACollisionClearanceService::Get: Cannot get the clearance service of a null world.");
+
+	// Find or spawn the service.
+	ACollisionClearanceService* service = GetWorldService<ACollisionClearanceService>(world);
+	CHECK_RETURN_NULL(LogCollisionClearance, !service, "ACollisionClearanceService::Get: Failed to spawn the clearance service.");
+	return service;
+}
+
+void ACollisionClearanceService::WaitUntilClear(UPrimitiveComponent* comp, ECollisionChannel channel, const TArray<AActor*>& ignoredActors, FOnCollisionClear onClear, float delay)
+{
+	FClearanceWait newWait;
+	newWait.channel = channel;
+	newWait.useObjectTypes = false;
+	AddWait(newWait, comp, ignoredActors, onClear, delay);
+}
+
+void ACollisionClearanceService::WaitUntilClear(UPrimitiveComponent* comp, const TArray<TEnumAsByte<EObjectTypeQuery>>& objectTypes, const TArray<AActor*>& ignoredActors, FOnCollisionClear onClear, float delay)
+{
+	FClearanceWait newWait;
+	newWait.objectParams = FCollisionObjectQueryParams(objectTypes);
+	newWait.channel = ECC_WorldDynamic;
+	newWait.useObjectTypes = true;
+	AddWait(newWait, comp, ignoredActors, onClear, delay);
+}
+
+void ACollisionClearanceService::AddWait(FClearanceWait& newWait, UPrimitiveComponent* comp, const TArray<AActor*>& ignoredActors, FOnCollisionClear onClear, float delay)
+{
+	CHECK_RETURN(LogCollisionClearance, !comp, "ACollisionClearanceService::WaitUntilClear: Cannot wait for a null component.");
+
+	// Replace any wait already running for this component.
+	CancelWait(comp);
+
+	newWait.component = comp;
+	newWait.ignoredActors.Reserve(ignoredActors.Num());
+	for (AActor* actor : ignoredActors) newWait.ignoredActors.Add(actor);
+	newWait.onClear = onClear;
+	newWait.startTime = GetWorld()->GetTimeSeconds() + FMath::Max(delay, 0.0f);
+	newWait.nextFullQueryTime = newWait.startTime;
+	newWait.needsFullQuery = true;
+	newWait.pairTesting = true;
+	waits.Add(MoveTemp(newWait));
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug) UE_LOG(LogCollisionClearance, Log, TEXT("%s is waiting to be clear of collision."), *comp->GetName());
+#endif
+}
+
+void ACollisionClearanceService::CancelWait(UPrimitiveComponent* comp)
+{
+	for (int32 i = waits.Num() - 1; i >= 0; i--)
+	{
+		if (waits[i].component.Get() == comp) waits.RemoveAtSwap(i, 1, false);
+	}
+}
+
+bool ACollisionClearanceService::IsWaiting(UPrimitiveComponent* comp) const
+{
+	for (const FClearanceWait& wait : waits)
+	{
+		if (wait.component.Get() == comp) return true;
+	}
+	return false;
+}
+
+void ACollisionClearanceService::RunFullQuery(FClearanceWait& wait)
+{
+	UPrimitiveComponent* comp = wait.component.Get();
+	wait.blockers.Reset();
+	overlapResults.Reset();
+
+	// Ignore the given actors.
+	FComponentQueryParams params(SCENE_QUERY_STAT(CollisionClearance));
+	for (const TWeakObjectPtr<AActor>& actor : wait.ignoredActors)
+	{
+		if (actor.IsValid()) params.AddIgnoredActor(actor.Get());
+	}
+
+	// Query by object type or by channel.
+	if (wait.useObjectTypes)
+	{
+		GetWorld()->ComponentOverlapMulti(overlapResults, comp, comp->GetComponentLocation(), comp->GetComponentQuat(), params, wait.objectParams);
+	}
+	else GetWorld()->ComponentOverlapMultiByChannel(overlapResults, comp, comp->GetComponentLocation(), comp->GetComponentQuat(), wait.channel, params);
+
+	// Keep components that count as blocking.
+	for (const FOverlapResult& result : overlapResults)
+	{
+		UPrimitiveComponent* overlappingComp = result.Component.Get();
+		if (!overlappingComp) continue;
+		if (!wait.useObjectTypes && (overlappingComp->GetCollisionResponseToChannel(wait.channel) != ECR_Block || overlappingComp->GetCollisionEnabled() != ECollisionEnabled::QueryAndPhysics)) continue;
+		wait.blockers.AddUnique(overlappingComp);
+	}
+}
+
+bool ACollisionClearanceService::StillOverlapping(UPrimitiveComponent* comp, UPrimitiveComponent* blocker, bool& canPairTest)
+{
+	canPairTest = true;
+	FCollisionQueryParams params(SCENE_QUERY_STAT(CollisionClearancePair));
+
+	// Test the geometry of the single body component against the other, skeletal meshes can only be tested from their own side.
+	if (!comp->IsA<USkeletalMeshComponent>()) return blocker->ComponentOverlapComponent(comp, comp->GetComponentLocation(), comp->GetComponentQuat(), params);
+	if (!blocker->IsA<USkeletalMeshComponent>()) return comp->ComponentOverlapComponent(blocker, blocker->GetComponentLocation(), blocker->GetComponentQuat(), params);
+
+	// Two multi body components cannot be pair tested.
+	canPairTest = false;
+	return true;
+}
+
+void ACollisionClearanceService::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	RETURN(waits.Num() == 0);
+
+	const float currentTime = GetWorld()->GetTimeSeconds();
+	TArray<FOnCollisionClear, TInlineAllocator<4>> cleared;
+	TArray<UPrimitiveComponent*, TInlineAllocator<8>> pairCleared;
+
+	for (int32 i = waits.Num() - 1; i >= 0; i--)
+	{
+		FClearanceWait& wait = waits[i];
+		UPrimitiveComponent* comp = wait.component.Get();
+
+		// Remove waits for destroyed components.
+		if (!comp)
+		{
+			waits.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+		if (currentTime < wait.startTime) continue;
+
+		// Pair test each known blocker, removing the ones that have moved clear.
+		pairCleared.Reset();
+		if (!wait.needsFullQuery)
+		{
+			bool untestable = !wait.pairTesting;
+			if (wait.pairTesting)
+			{
+				for (int32 b = wait.blockers.Num() - 1; b >= 0; b--)
+				{
+					UPrimitiveComponent* blocker = wait.blockers[b].Get();
+					bool canPairTest = true;
+					bool blocking = blocker && blocker->IsCollisionEnabled();
+					if (blocking && !wait.useObjectTypes) blocking = blocker->GetCollisionEnabled() == ECollisionEnabled::QueryAndPhysics;
+					if (blocking)
+					{
+						blocking = StillOverlapping(comp, blocker, canPairTest);
+						if (!blocking) pairCleared.Add(blocker);
+					}
+					if (!blocking) wait.blockers.RemoveAtSwap(b, 1, false);
+					untestable |= !canPairTest;
+				}
+			}
+
+			// Confirm with a full query once every blocker is clear, as something new may have moved in. Otherwise fall back to querying at an interval.
+			wait.needsFullQuery = wait.blockers.Num() == 0 || (untestable && currentTime >= wait.nextFullQueryTime);
+		}
+
+		if (wait.needsFullQuery)
+		{
+			RunFullQuery(wait);
+			wait.needsFullQuery = false;
+			wait.nextFullQueryTime = currentTime + fullQueryInterval;
+
+			// Clear, call back and remove the wait.
+			if (wait.blockers.Num() == 0)
+			{
+				cleared.Add(wait.onClear);
+				waits.RemoveAtSwap(i, 1, false);
+				continue;
+			}
+
+			// A pair test cleared a blocker the full query still finds, stop pair testing this wait to prevent a full query every frame.
+			// Otherwise something new has moved in, keep pair testing against the blockers from the full query.
+			for (const TWeakObjectPtr<UPrimitiveComponent>& blocker : wait.blockers)
+			{
+				if (pairCleared.Contains(blocker.Get()))
+				{
+					wait.pairTesting = false;
+					break;
+				}
+			}
+		}
+	}
+
+	// Call back after updating as callbacks can start new waits.
+	for (FOnCollisionClear& onClear : cleared)
+	{
+		onClear.ExecuteIfBound();
+	}
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Engine/EngineTypes.h"
+#include "Globals.h"
+#include "CollisionClearanceService.generated.h"
+
+/** Define this actors log category. */
+DECLARE_LOG_CATEGORY_EXTERN(LogCollisionClearance, Log, All);
+
+/** Delegate called once a component waiting in the clearance service is no longer overlapping anything. */
+DECLARE_DELEGATE(FOnCollisionClear);
+
+/** Declare classes used. */
+class UPrimitiveComponent;
+
+/** World level service to wait until a component is no longer overlapping any blocking collision before calling back, used to re-enable
+ * hand and head collision after grabbing, releasing or teleporting. A full overlap query is only ran when a wait starts and when every known
+ * blocker has moved clear, in-between each known blocker is tested with a single pair test every frame so collision is re-enabled on the
+ * first frame it is clear.
+ * NOTE: Spawned on demand through Get(), there should only ever be one per world. */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class VRTEMPLATE_API ACollisionClearanceService : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Time between full overlap queries when a blocker cannot be pair tested. (Skeletal meshes against skeletal meshes) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Clearance")
+	float fullQueryInterval;
+
+	/** Enable any debug messages for this class.
+	 * NOTE: Only used when DEVELOPMENT = 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Clearance")
+	bool debug;
+
+private:
+
+	/** A component waiting to be clear of blocking collision. */
+	struct FClearanceWait
+	{
+		TWeakObjectPtr<UPrimitiveComponent> component; /** The component waiting. */
+		TArray<TWeakObjectPtr<AActor>> ignoredActors; /** Actors to ignore in the overlap query. */
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> blockers; /** Components known to be overlapping from the last full query. */
+		FCollisionObjectQueryParams objectParams; /** Object types to query when useObjectTypes is true. */
+		ECollisionChannel channel; /** Channel to query when useObjectTypes is false, only blocking components count. */
+		FOnCollisionClear onClear; /** Called when clear. */
+		float startTime; /** World time to start checking at. */
+		float nextFullQueryTime; /** World time of the next full query when there are blockers that cannot be pair tested. */
+		bool useObjectTypes; /** Query by object types instead of by channel. */
+		bool needsFullQuery; /** Run a full query on the next update. */
+		bool pairTesting; /** Pair test the known blockers each frame, disabled if a blocker a pair test cleared is still found by the full query. */
+	};
+
+	TArray<FClearanceWait> waits; /** Components currently waiting. */
+	TArray<FOverlapResult> overlapResults; /** Re-used overlap query results. */
+
+private:
+
+	/** Start a wait for the component, replacing any current wait for it. */
+	void AddWait(FClearanceWait& newWait, UPrimitiveComponent* comp, const TArray<AActor*>& ignoredActors, FOnCollisionClear onClear, float delay);
+
+	/** Run a full overlap query for the wait filling its blockers. */
+	void RunFullQuery(FClearanceWait& wait);
+
+	/** @Return false if the pair is known to no longer overlap, true if overlapping or the pair can't be tested. */
+	static bool StillOverlapping(UPrimitiveComponent* comp, UPrimitiveComponent* blocker, bool& canPairTest);
+
+public:
+
+	/** Constructor. */
+	ACollisionClearanceService();
+
+	/** Check each waiting component. */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Get the clearance service for the given world, spawning one if it doesn't exist yet.
+	 * @Param world, The world to get the service for. */
+	static ACollisionClearanceService* Get(UWorld* world);
+
+	/** Wait until the component is not overlapping any component blocking the given channel.
+	 * @Param comp, The component to wait for.
+	 * @Param channel, The channel to check, only components blocking this channel with query and physics collision count.
+	 * @Param ignoredActors, Actors to ignore.
+	 * @Param onClear, Called once clear.
+	 * @Param delay, Time to wait before the first check. */
+	void WaitUntilClear(UPrimitiveComponent* comp, ECollisionChannel channel, const TArray<AActor*>& ignoredActors, FOnCollisionClear onClear, float delay = 0.0f);
+
+	/** Wait until the component is not overlapping any component of the given object types.
+	 * @Param comp, The component to wait for.
+	 * @Param objectTypes, The object types to check.
+	 * @Param ignoredActors, Actors to ignore.
+	 * @Param onClear, Called once clear.
+	 * @Param delay, Time to wait before the first check. */
+	void WaitUntilClear(UPrimitiveComponent* comp, const TArray<TEnumAsByte<EObjectTypeQuery>>& objectTypes, const TArray<AActor*>& ignoredActors, FOnCollisionClear onClear, float delay = 0.0f);
+
+	/** Stop waiting for the component without calling back. */
+	void CancelWait(UPrimitiveComponent* comp);
+
+	/** @Return true if the component is currently waiting to be clear. */
+	bool IsWaiting(UPrimitiveComponent* comp) const;
+};
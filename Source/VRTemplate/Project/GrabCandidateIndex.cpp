@@ -0,0 +1,379 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/GrabCandidateIndex.h"
+#include "Project/WorldService.h"
+#include "Player/VRHand.h"
+#include "Player/HandsInterface.h"
+#include "Player/HandsInterfaceCache.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+
+DEFINE_LOG_CATEGORY(LogGrabCandidateIndex);
+
+AGrabCandidateIndex::AGrabCandidateIndex()
+{
+	// Nothing to tick, the index is only updated when queried.
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Initialise default variables.
+	cellSize = 50.0f;
+	maxCellSpan = 8;
+	currentQueryStamp = 0;
+	initialised = false;
+
+#if WITH_EDITOR
+	debug = false;
+#endif
+}
+
+AGrabCandidateIndex* AGrabCandidateIndex::Get(UWorld* world)
+{
+	CHECK_RETURN_NULL(LogGrabCandidateIndex, !world, "AGrabCandidateIndex::Get: Cannot get the grab candidate index of a null world.");
+
+	// Find or spawn the index, it is only populated the first time.
+	AGrabCandidateIndex* index = GetWorldService<AGrabCandidateIndex>(world);
+	CHECK_RETURN_NULL(LogGrabCandidateIndex, !index, "AGrabCandidateIndex::Get: Failed to spawn the grab candidate index.");
+	index->BuildIndex();
+	return index;
+}
+
+void AGrabCandidateIndex::BuildIndex()
+{
+	RETURN(initialised);
+	initialised = true;
+
+	// Register all actors currently in the world.
+	for (TActorIterator<AActor> it(GetWorld()); it; ++it)
+	{
+		RegisterActor(*it);
+	}
+
+	// Register any actors spawned from now on.
+	actorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AGrabCandidateIndex::OnActorSpawned));
+
+	// Register actors in levels streamed in later and remove them when streamed out.
+	levelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &AGrabCandidateIndex::OnLevelAdded);
+	levelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &AGrabCandidateIndex::OnLevelRemoved);
+
+	// Register components created or registered after their actor spawned, primitives that can be overlapped always create a physics state.
+	// This also re-checks components rejected earlier, as re-attaching or changing collision recreates the physics state.
+	physicsCreatedHandle = UActorComponent::GlobalCreatePhysicsDelegate.AddUObject(this, &AGrabCandidateIndex::OnComponentPhysicsCreated);
+	physicsDestroyedHandle = UActorComponent::GlobalDestroyPhysicsDelegate.AddUObject(this, &AGrabCandidateIndex::OnComponentPhysicsDestroyed);
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug) UE_LOG(LogGrabCandidateIndex, Log, TEXT("Grab candidate index built with %d candidates in %d cells."), componentLookup.Num(), cells.Num());
+#endif
+}
+
+void AGrabCandidateIndex::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// Stop listening for spawned actors, streamed levels, components and moving candidates.
+	if (GetWorld()) GetWorld()->RemoveOnActorSpawnedHandler(actorSpawnedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(levelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(levelRemovedHandle);
+	UActorComponent::GlobalCreatePhysicsDelegate.Remove(physicsCreatedHandle);
+	UActorComponent::GlobalDestroyPhysicsDelegate.Remove(physicsDestroyedHandle);
+	for (FGrabCandidate& candidate : candidates)
+	{
+		if (UPrimitiveComponent* comp = candidate.component.Get()) comp->TransformUpdated.RemoveAll(this);
+	}
+}
+
+void AGrabCandidateIndex::OnActorSpawned(AActor* actor)
+{
+	RegisterActor(actor);
+}
+
+void AGrabCandidateIndex::OnLevelAdded(ULevel* level, UWorld* world)
+{
+	RETURN(!level || world != GetWorld());
+	for (AActor* actor : level->Actors)
+	{
+		RegisterActor(actor);
+	}
+}
+
+void AGrabCandidateIndex::OnLevelRemoved(ULevel* level, UWorld* world)
+{
+	RETURN(world != GetWorld());
+
+	// A null level means every level is being removed.
+	for (int32 i = 0; i < candidates.Num(); i++)
+	{
+		if (!candidates[i].inUse) continue;
+		UPrimitiveComponent* comp = candidates[i].component.Get();
+		if (!comp || !level || comp->GetComponentLevel() == level) RemoveCandidate(i);
+	}
+}
+
+void AGrabCandidateIndex::OnComponentPhysicsCreated(UActorComponent* comp)
+{
+	UPrimitiveComponent* primitive = Cast<UPrimitiveComponent>(comp);
+	if (primitive && primitive->GetWorld() == GetWorld()) RefreshCandidate(primitive);
+}
+
+void AGrabCandidateIndex::OnComponentPhysicsDestroyed(UActorComponent* comp)
+{
+	// Ignore components from other worlds, they will never be in this index.
+	UPrimitiveComponent* primitive = Cast<UPrimitiveComponent>(comp);
+	if (primitive && primitive->GetWorld() == GetWorld()) UnregisterCandidate(primitive);
+}
+
+void AGrabCandidateIndex::RegisterActor(AActor* actor)
+{
+	RETURN(!actor || actor == this);
+
+	// Register each primitive component of the actor.
+	TInlineComponentArray<UPrimitiveComponent*> primitives(actor);
+	for (UPrimitiveComponent* comp : primitives)
+	{
+		RegisterCandidate(comp);
+	}
+}
+
+bool AGrabCandidateIndex::IsGrabCandidate(UPrimitiveComponent* comp)
+{
+	// Only components the hands can overlap, that are tagged as grabbable or resolve to a hands interface.
+	if (!comp->GetGenerateOverlapEvents()) return false;
+	if (comp->ComponentHasTag(FName("Grabbable")) || comp->GetOwner()->ActorHasTag(FName("Grabbable"))) return true;
+	return FHandsInterfaceCache::Get().Resolve(comp) != nullptr;
+}
+
+bool AGrabCandidateIndex::RegisterCandidate(UPrimitiveComponent* comp)
+{
+	if (!comp || !comp->IsRegistered() || !comp->GetOwner()) return false;
+	if (componentLookup.Contains(comp)) return true;
+	if (!IsGrabCandidate(comp)) return false;
+
+	// Reuse a free slot if there is one.
+	int32 index;
+	if (freeSlots.Num() > 0) index = freeSlots.Pop(false);
+	else index = candidates.AddDefaulted();
+
+	// Setup the new candidate and bin it into the grid.
+	FGrabCandidate& candidate = candidates[index];
+	candidate = FGrabCandidate();
+	candidate.component = comp;
+	candidate.inUse = true;
+	componentLookup.Add(comp, index);
+	BinCandidate(index);
+
+	// Re-bin the candidate whenever it moves. Sleeping or static bodies will never fire this.
+	comp->TransformUpdated.AddUObject(this, &AGrabCandidateIndex::OnCandidateMoved);
+	return true;
+}
+
+void AGrabCandidateIndex::RefreshCandidate(USceneComponent* comp)
+{
+	RETURN(!comp);
+
+	// Re-check the component and everything attached below it, as attaching can change which interface its children resolve to.
+	TArray<USceneComponent*> components;
+	comp->GetChildrenComponents(true, components);
+	components.Add(comp);
+	for (USceneComponent* sceneComp : components)
+	{
+		FHandsInterfaceCache::Get().Invalidate(sceneComp);
+		UPrimitiveComponent* primitive = Cast<UPrimitiveComponent>(sceneComp);
+		if (!primitive) continue;
+		if (primitive->IsRegistered() && primitive->GetOwner() && IsGrabCandidate(primitive)) RegisterCandidate(primitive);
+		else UnregisterCandidate(primitive);
+	}
+}
+
+void AGrabCandidateIndex::UnregisterCandidate(UPrimitiveComponent* comp)
+{
+	if (int32* foundIndex = componentLookup.Find(comp)) RemoveCandidate(*foundIndex);
+}
+
+void AGrabCandidateIndex::RemoveCandidate(int32 index)
+{
+	FGrabCandidate& candidate = candidates[index];
+	RETURN(!candidate.inUse);
+
+	// Remove from the grid and lookup then free the slot.
+	UnbinCandidate(index);
+	if (UPrimitiveComponent* comp = candidate.component.Get()) comp->TransformUpdated.RemoveAll(this);
+	componentLookup.Remove(candidate.component);
+	candidate = FGrabCandidate();
+	freeSlots.Add(index);
+}
+
+void AGrabCandidateIndex::OnCandidateMoved(USceneComponent* movedComp, EUpdateTransformFlags updateFlags, ETeleportType teleport)
+{
+	// Flag the candidate as dirty, it will be re-binned on the next query.
+	if (int32* foundIndex = componentLookup.Find(Cast<UPrimitiveComponent>(movedComp)))
+	{
+		FGrabCandidate& candidate = candidates[*foundIndex];
+		if (!candidate.dirty)
+		{
+			candidate.dirty = true;
+			dirtyCandidates.Add(*foundIndex);
+		}
+	}
+}
+
+void AGrabCandidateIndex::FlushDirtyCandidates()
+{
+	for (int32 index : dirtyCandidates)
+	{
+		FGrabCandidate& candidate = candidates[index];
+		if (!candidate.inUse) continue;
+		candidate.dirty = false;
+
+		// Remove destroyed candidates or ones no longer grabbable, otherwise re-bin them only if the cells they cover has changed.
+		UPrimitiveComponent* comp = candidate.component.Get();
+		if (!comp || !comp->GetOwner() || !IsGrabCandidate(comp))
+		{
+			RemoveCandidate(index);
+			continue;
+		}
+		const FBox bounds = comp->Bounds.GetBox();
+		if (candidate.oversized || ToCell(bounds.Min) != candidate.minCell || ToCell(bounds.Max) != candidate.maxCell)
+		{
+			UnbinCandidate(index);
+			BinCandidate(index);
+		}
+	}
+	dirtyCandidates.Reset();
+}
+
+void AGrabCandidateIndex::BinCandidate(int32 index)
+{
+	FGrabCandidate& candidate = candidates[index];
+	UPrimitiveComponent* comp = candidate.component.Get();
+	RETURN(!comp);
+
+	// Find the cell range of the components bounds.
+	const FBox bounds = comp->Bounds.GetBox();
+	candidate.minCell = ToCell(bounds.Min);
+	candidate.maxCell = ToCell(bounds.Max);
+	const FIntVector span = candidate.maxCell - candidate.minCell;
+
+	// Store large candidates separately to avoid filling a huge amount of cells.
+	candidate.oversized = span.GetMax() > maxCellSpan;
+	if (candidate.oversized)
+	{
+		oversizedCandidates.Add(index);
+		return;
+	}
+
+	// Add to each cell covered.
+	for (int32 x = candidate.minCell.X; x <= candidate.maxCell.X; x++)
+	{
+		for (int32 y = candidate.minCell.Y; y <= candidate.maxCell.Y; y++)
+		{
+			for (int32 z = candidate.minCell.Z; z <= candidate.maxCell.Z; z++)
+			{
+				cells.FindOrAdd(FIntVector(x, y, z)).Add(index);
+			}
+		}
+	}
+}
+
+void AGrabCandidateIndex::UnbinCandidate(int32 index)
+{
+	FGrabCandidate& candidate = candidates[index];
+	if (candidate.oversized)
+	{
+		oversizedCandidates.RemoveSingleSwap(index, false);
+		candidate.oversized = false;
+		return;
+	}
+
+	// Remove from each cell covered, empty cells are kept to prevent re-allocating them when something moves back.
+	for (int32 x = candidate.minCell.X; x <= candidate.maxCell.X; x++)
+	{
+		for (int32 y = candidate.minCell.Y; y <= candidate.maxCell.Y; y++)
+		{
+			for (int32 z = candidate.minCell.Z; z <= candidate.maxCell.Z; z++)
+			{
+				if (TArray<int32>* cell = cells.Find(FIntVector(x, y, z))) cell->RemoveSingleSwap(index, false);
+			}
+		}
+	}
+}
+
+UObject* AGrabCandidateIndex::FindClosestCandidate(UPrimitiveComponent* queryComp)
+{
+	CHECK_RETURN_NULL(LogGrabCandidateIndex, !queryComp, "AGrabCandidateIndex::FindClosestCandidate: The query component is null.");
+	if (!queryComp->IsQueryCollisionEnabled()) return nullptr;
+
+	// Bring the grid up to date with anything that has moved.
+	FlushDirtyCandidates();
+
+	// Get the query shape and the cells it covers.
+	const FBox queryBounds = queryComp->Bounds.GetBox();
+	const FVector queryLocation = queryComp->GetComponentLocation();
+	const FQuat queryRotation = queryComp->GetComponentQuat();
+	const FCollisionShape queryShape = queryComp->GetCollisionShape();
+	const FIntVector minCell = ToCell(queryBounds.Min);
+	const FIntVector maxCell = ToCell(queryBounds.Max);
+	currentQueryStamp++;
+
+	UObject* closest = nullptr;
+	float smallestDistance = MAX_FLT;
+
+	// Test a single candidate against the query shape, updating the closest interactable found.
+	auto testCandidate = [&](int32 index)
+	{
+		FGrabCandidate& candidate = candidates[index];
+		if (candidate.queryStamp == currentQueryStamp) return;
+		candidate.queryStamp = currentQueryStamp;
+
+		// Skip destroyed candidates, they will be removed next time they're flushed.
+		UPrimitiveComponent* comp = candidate.component.Get();
+		if (!comp)
+		{
+			if (!candidate.dirty)
+			{
+				candidate.dirty = true;
+				dirtyCandidates.Add(index);
+			}
+			return;
+		}
+
+		// Broad phase, same filtering as the overlap events would apply.
+		if (!comp->IsQueryCollisionEnabled() || !comp->GetGenerateOverlapEvents()) return;
+		if (queryComp->GetCollisionResponseToComponent(comp) == ECR_Ignore) return;
+		if (!comp->Bounds.GetBox().Intersect(queryBounds)) return;
+
+		// Only compute the narrow phase if this candidate would be closer and resolves to an interface, the lookup is cached.
+		const float distance = (comp->GetComponentLocation() - queryLocation).SizeSquared();
+		if (distance >= smallestDistance) return;
+		UObject* interfaceObject = AVRHand::LookForInterface(comp);
+		if (!interfaceObject) return;
+		if (!comp->OverlapComponent(queryLocation, queryRotation, queryShape)) return;
+
+		// Make sure this interface is currently allowing interaction.
+		FHandInterfaceSettings settingsCopy;
+		if (!IHandsInterface::ReadInterfaceSettings(interfaceObject, settingsCopy).canInteract) return;
+
+		smallestDistance = distance;
+		closest = interfaceObject;
+	};
+
+	// Test each candidate in the covered cells.
+	for (int32 x = minCell.X; x <= maxCell.X; x++)
+	{
+		for (int32 y = minCell.Y; y <= maxCell.Y; y++)
+		{
+			for (int32 z = minCell.Z; z <= maxCell.Z; z++)
+			{
+				if (const TArray<int32>* cell = cells.Find(FIntVector(x, y, z)))
+				{
+					for (int32 index : *cell) testCandidate(index);
+				}
+			}
+		}
+	}
+
+	// Test candidates too large for the grid.
+	for (int32 index : oversizedCandidates) testCandidate(index);
+
+	return closest;
+}
@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Globals.h"
+#include "GrabCandidateIndex.generated.h"
+
+/** Define this actors log category. */
+DECLARE_LOG_CATEGORY_EXTERN(LogGrabCandidateIndex, Log, All);
+
+/** Declare classes used. */
+class UPrimitiveComponent;
+class USceneComponent;
+class UActorComponent;
+class ULevel;
+
+/** Single entry in the grab candidate index, one per registered grabbable primitive component.
+ * NOTE: The interface owner is resolved through the hands interface cache on query so re-attached or re-tagged components stay correct. */
+struct FGrabCandidate
+{
+	TWeakObjectPtr<UPrimitiveComponent> component; /** The registered primitive component that the hand can overlap. */
+	FIntVector minCell, maxCell; /** Cell range this candidates bounds are currently binned into. */
+	uint32 queryStamp; /** Last query this candidate was tested in. Prevents testing twice when spanning multiple cells. */
+	bool oversized; /** Bounds too large for the grid, stored in the oversized list instead of the cells. */
+	bool dirty; /** Candidate has moved since it was last binned. */
+	bool inUse; /** Is this slot currently holding a candidate. */
+
+	FGrabCandidate()
+	{
+		minCell = FIntVector::ZeroValue;
+		maxCell = FIntVector::ZeroValue;
+		queryStamp = 0;
+		oversized = false;
+		dirty = false;
+		inUse = false;
+	}
+};
+
+/** World level spatial index of everything the hands can grab. Interactables are binned into a uniform grid by their bounds and
+ * only re-binned when they move, so sleeping or static interactables cost nothing per frame. The hands query this with their grab
+ * collider instead of scanning overlaps every frame.
+ * NOTE: Spawned on demand through Get(), there should only ever be one per world. */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class VRTEMPLATE_API AGrabCandidateIndex : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Size of each grid cell in world units. Should be a bit bigger than the average interactable. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GrabIndex")
+	float cellSize;
+
+	/** Candidates spanning more cells than this on any axis are stored in the oversized list and tested on every query. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GrabIndex")
+	int maxCellSpan;
+
+	/** Enable any debug messages for this class.
+	 * NOTE: Only used when DEVELOPMENT = 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GrabIndex")
+	bool debug;
+
+protected:
+
+	/** Level end or destroyed. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	TArray<FGrabCandidate> candidates; /** Every candidate slot, free slots are reused from freeSlots. */
+	TArray<int32> freeSlots; /** Indexes of unused slots in the candidates array. */
+	TArray<int32> dirtyCandidates; /** Candidates that have moved since the last query. */
+	TArray<int32> oversizedCandidates; /** Candidates too large to bin into the grid. */
+	TMap<FIntVector, TArray<int32>> cells; /** Uniform grid of candidate indexes. */
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, int32> componentLookup; /** Find a candidates slot from its component. */
+	FDelegateHandle actorSpawnedHandle; /** Handle to the worlds actor spawned delegate. */
+	FDelegateHandle levelAddedHandle; /** Handle to the level added to world delegate. */
+	FDelegateHandle levelRemovedHandle; /** Handle to the level removed from world delegate. */
+	FDelegateHandle physicsCreatedHandle; /** Handle to the global component physics state created delegate. */
+	FDelegateHandle physicsDestroyedHandle; /** Handle to the global component physics state destroyed delegate. */
+	uint32 currentQueryStamp; /** Incremented every query to de-duplicate candidates spanning multiple cells. */
+	bool initialised; /** Has the index been populated from the world yet. */
+
+private:
+
+	/** Populate the index with every primitive currently in the world and listen for new actors, streamed levels and components. */
+	void BuildIndex();
+
+	/** Called when an actor is spawned in the world to register its primitive components. */
+	void OnActorSpawned(AActor* actor);
+
+	/** Called when a level is streamed into a world, registers the primitive components of each actor in the level. */
+	void OnLevelAdded(ULevel* level, UWorld* world);
+
+	/** Called when a level is streamed out of a world, removes the candidates owned by actors in the level. */
+	void OnLevelRemoved(ULevel* level, UWorld* world);
+
+	/** Called when any component creates its physics state, registers primitives added or registered after their actor spawned
+	 * and re-checks components whose collision or attachment has changed. */
+	void OnComponentPhysicsCreated(UActorComponent* comp);
+
+	/** Called when any component destroys its physics state, removes it from the index. */
+	void OnComponentPhysicsDestroyed(UActorComponent* comp);
+
+	/** Called when a registered component is moved. Marks the candidate as dirty to be re-binned on the next query. */
+	void OnCandidateMoved(USceneComponent* movedComp, EUpdateTransformFlags updateFlags, ETeleportType teleport);
+
+	/** @Return true if the component generates overlap events and is tagged as grabbable or resolves to a hands interface. */
+	bool IsGrabCandidate(UPrimitiveComponent* comp);
+
+	/** Re-bin all dirty candidates and remove any that have been destroyed or are no longer grabbable. */
+	void FlushDirtyCandidates();
+
+	/** Add the candidate at index into the cells covered by its components bounds. */
+	void BinCandidate(int32 index);
+
+	/** Remove the candidate at index from the cells it is binned into. */
+	void UnbinCandidate(int32 index);
+
+	/** Remove the candidate at index completely and free its slot. */
+	void RemoveCandidate(int32 index);
+
+	/** Convert a world location into a grid cell. */
+	FORCEINLINE FIntVector ToCell(const FVector& location) const
+	{
+		return FIntVector(FMath::FloorToInt(location.X / cellSize), FMath::FloorToInt(location.Y / cellSize), FMath::FloorToInt(location.Z / cellSize));
+	}
+
+public:
+
+	/** Constructor. */
+	AGrabCandidateIndex();
+
+	/** Get the grab candidate index for the given world, spawning and populating one if it doesn't exist yet.
+	 * @Param world, The world to get the index for. */
+	static AGrabCandidateIndex* Get(UWorld* world);
+
+	/** Register each primitive component of the given actor.
+	 * @Param actor, The actor to register. */
+	void RegisterActor(AActor* actor);
+
+	/** Register a primitive component as a grab candidate. Only components generating overlap events that are tagged as grabbable
+	 * or resolve to a hands interface are added, everything else in the world is ignored.
+	 * @Param comp, The component to register.
+	 * @Return true if the component is now in the index. */
+	bool RegisterCandidate(UPrimitiveComponent* comp);
+
+	/** Re-check whether a component and its attached children are grab candidates, adding or removing them from the index.
+	 * NOTE: Call after adding the Grabbable tag or attaching to an interactable at runtime without recreating the physics state.
+	 * @Param comp, The component to re-check. */
+	void RefreshCandidate(USceneComponent* comp);
+
+	/** Remove a primitive component from the index.
+	 * @Param comp, The component to remove. */
+	void UnregisterCandidate(UPrimitiveComponent* comp);
+
+	/** Find the closest interactable overlapping the query component that currently allows interaction.
+	 * @Param queryComp, The component to test overlaps with. (The hands grab collider)
+	 * @Return The object implementing the hands interface, nullptr if nothing was found. */
+	UObject* FindClosestCandidate(UPrimitiveComponent* queryComp);
+};
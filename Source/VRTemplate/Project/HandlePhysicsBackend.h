@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** Declare classes used. */
+class UPrimitiveComponent;
+struct FPhysicsHandleData;
+
+/** Interface between the VR physics handles and the physics engine. Each grab is a joint from a kinematic target to the grabbed body, referred
+ * to by an id, so the handle, hand and grabbable code never touches the physics engine directly. Implemented for PhysX and as a CPU mock that
+ * needs no physics scene, so grabbing, releasing and dragging can be ran in automation tests and timed on a headless build.
+ * NOTE: Owned by the worlds physics handle manager, use APhysicsHandleManager::GetBackend. */
+class VRTEMPLATE_API IHandlePhysicsBackend
+{
+public:
+
+	/** Destructor. */
+	virtual ~IHandlePhysicsBackend() {}
+
+	/** Create a kinematic target at the joint pose and a joint from it to the body.
+	 * @Param comp, The component to constrain.
+	 * @Param boneName, The bone of the component to constrain.
+	 * @Param jointPose, The world pose of the joint and target.
+	 * @Return the id of the joint, INDEX_NONE if it could not be created. */
+	virtual int32 CreateJoint(UPrimitiveComponent* comp, FName boneName, const FTransform& jointPose) = 0;
+
+	/** Destroy the joint and its kinematic target.
+	 * @Param joint, The id of the joint. */
+	virtual void DestroyJoint(int32 joint) = 0;
+
+	/** Setup the joints motions and drives.
+	 * @Param joint, The id of the joint.
+	 * @Param data, The handle data to setup the drives from.
+	 * @Param rotationConstraint, Should the joint constrain rotation. */
+	virtual void SetupJoint(int32 joint, const FPhysicsHandleData& data, bool rotationConstraint) = 0;
+
+	/** Run the callable with the scene write locked, used to move many targets under one lock.
+	 * @Param callable, The function to run. */
+	virtual void ExecuteWrite(TFunctionRef<void()> callable) = 0;
+
+	/** @Return the current pose of the joints kinematic target. NOTE: The scene must already be write locked. */
+	virtual FTransform GetTargetPose_AssumesLocked(int32 joint) const = 0;
+
+	/** Move the joints kinematic target to the pose during the next physics step.
+	 * NOTE: The scene must already be write locked.
+	 * @Param joint, The id of the joint.
+	 * @Param pose, The new world pose of the target. */
+	virtual void SetTargetPose_AssumesLocked(int32 joint, const FTransform& pose) = 0;
+
+	/** Step any simulation the backend runs itself, ran after the targets are moved each frame. The physics engine steps its own scene.
+	 * @Param deltaTime, The frame delta time. */
+	virtual void Step(float deltaTime) {}
+
+	/** @Return true if the physics scene is substepping and the targets can be moved in each substep. */
+	virtual bool IsSubstepping() const { return false; }
+
+	/** @Return the number of joints currently created. */
+	virtual int32 GetNumActiveJoints() const = 0;
+
+	/** Remove any unused joints and targets, joints still in use are removed when destroyed. Ran on end play. */
+	virtual void Release() = 0;
+};
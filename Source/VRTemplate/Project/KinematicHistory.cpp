@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/KinematicHistory.h"
+
+FKinematicHistory::FKinematicHistory()
+{
+	newestSample = 0;
+	numSamples = 0;
+}
+
+void FKinematicHistory::AddSample(const FVector& location, const FQuat& rotation, float deltaTime)
+{
+	const double time = numSamples > 0 ? samples[newestSample].time + FMath::Max(deltaTime, 0.0f) : 0.0;
+	newestSample = (newestSample + 1) % capacity;
+	samples[newestSample].location = location;
+	samples[newestSample].rotation = rotation;
+	samples[newestSample].time = time;
+	numSamples = FMath::Min(numSamples + 1, capacity);
+}
+
+void FKinematicHistory::Reset()
+{
+	numSamples = 0;
+}
+
+const FKinematicSample& FKinematicHistory::GetSample(int32 age) const
+{
+	check(age >= 0 && age < numSamples);
+	return samples[(newestSample - age + capacity) % capacity];
+}
+
+int32 FKinematicHistory::NumInWindow(float window) const
+{
+	if (numSamples < 2) return numSamples;
+
+	// Always use at least the last two samples.
+	const double oldestTime = GetSample(0).time - window;
+	int32 count = 2;
+	while (count < numSamples && GetSample(count).time >= oldestTime) count++;
+	return count;
+}
+
+FVector FKinematicHistory::GetLinearVelocity(float window) const
+{
+	const int32 count = NumInWindow(window);
+	if (count < 2) return FVector::ZeroVector;
+
+	// Means of time and location, relative to the newest sample to keep precision.
+	const FKinematicSample& newest = GetSample(0);
+	float meanTime = 0.0f;
+	FVector meanLocation = FVector::ZeroVector;
+	for (int32 age = 0; age < count; age++)
+	{
+		meanTime += (float)(GetSample(age).time - newest.time);
+		meanLocation += GetSample(age).location - newest.location;
+	}
+	meanTime /= count;
+	meanLocation /= count;
+
+	// Slope of the best fit line through the samples.
+	float timeVariance = 0.0f;
+	FVector covariance = FVector::ZeroVector;
+	for (int32 age = 0; age < count; age++)
+	{
+		const float timeOffset = (float)(GetSample(age).time - newest.time) - meanTime;
+		timeVariance += timeOffset * timeOffset;
+		covariance += (GetSample(age).location - newest.location - meanLocation) * timeOffset;
+	}
+	return timeVariance > SMALL_NUMBER ? covariance / timeVariance : FVector::ZeroVector;
+}
+
+FVector FKinematicHistory::GetAngularVelocity(float window) const
+{
+	const int32 count = NumInWindow(window);
+	if (count < 2) return FVector::ZeroVector;
+
+	// Express each rotation as a world space rotation vector from the newest, these are small across the window so can be fitted linearly.
+	const FKinematicSample& newest = GetSample(0);
+	const FQuat newestInverse = newest.rotation.Inverse();
+	FVector rotationVectors[capacity];
+	float meanTime = 0.0f;
+	FVector meanRotation = FVector::ZeroVector;
+	for (int32 age = 0; age < count; age++)
+	{
+		FQuat deltaRotation = GetSample(age).rotation * newestInverse;
+		deltaRotation.EnforceShortestArcWith(FQuat::Identity);
+		FVector axis;
+		float angle;
+		deltaRotation.ToAxisAndAngle(axis, angle);
+		rotationVectors[age] = axis * angle;
+		meanTime += (float)(GetSample(age).time - newest.time);
+		meanRotation += rotationVectors[age];
+	}
+	meanTime /= count;
+	meanRotation /= count;
+
+	// Slope of the best fit line through the rotation vectors.
+	float timeVariance = 0.0f;
+	FVector covariance = FVector::ZeroVector;
+	for (int32 age = 0; age < count; age++)
+	{
+		const float timeOffset = (float)(GetSample(age).time - newest.time) - meanTime;
+		timeVariance += timeOffset * timeOffset;
+		covariance += (rotationVectors[age] - meanRotation) * timeOffset;
+	}
+	return timeVariance > SMALL_NUMBER ? covariance / timeVariance : FVector::ZeroVector;
+}
+
+FVector FKinematicHistory::GetPeakLinearVelocity(float window) const
+{
+	const int32 count = NumInWindow(window);
+	FVector peak = FVector::ZeroVector;
+
+	// Check the velocity between each pair of samples.
+	for (int32 age = 0; age < count - 1; age++)
+	{
+		const FKinematicSample& newer = GetSample(age);
+		const FKinematicSample& older = GetSample(age + 1);
+		const float deltaTime = (float)(newer.time - older.time);
+		if (deltaTime <= SMALL_NUMBER) continue;
+		const FVector velocity = (newer.location - older.location) / deltaTime;
+		if (velocity.SizeSquared() > peak.SizeSquared()) peak = velocity;
+	}
+	return peak;
+}
+
+float FKinematicHistory::GetSpeedChange(float window) const
+{
+	const int32 count = NumInWindow(window);
+	if (count < 3) return 0.0f;
+
+	// Speed between each pair of samples at the middle of the pair.
+	float times[capacity], speeds[capacity];
+	int32 numSpeeds = 0;
+	float meanTime = 0.0f, meanSpeed = 0.0f;
+	for (int32 age = 0; age < count - 1; age++)
+	{
+		const FKinematicSample& newer = GetSample(age);
+		const FKinematicSample& older = GetSample(age + 1);
+		const float deltaTime = (float)(newer.time - older.time);
+		if (deltaTime <= SMALL_NUMBER) continue;
+		times[numSpeeds] = (float)((newer.time + older.time) * 0.5 - GetSample(0).time);
+		speeds[numSpeeds] = (newer.location - older.location).Size() / deltaTime;
+		meanTime += times[numSpeeds];
+		meanSpeed += speeds[numSpeeds];
+		numSpeeds++;
+	}
+	if (numSpeeds < 2) return 0.0f;
+	meanTime /= numSpeeds;
+	meanSpeed /= numSpeeds;
+
+	// Slope of the best fit line through the speeds.
+	float timeVariance = 0.0f, covariance = 0.0f;
+	for (int32 i = 0; i < numSpeeds; i++)
+	{
+		timeVariance += (times[i] - meanTime) * (times[i] - meanTime);
+		covariance += (speeds[i] - meanSpeed) * (times[i] - meanTime);
+	}
+	return timeVariance > SMALL_NUMBER ? covariance / timeVariance : 0.0f;
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** A recorded transform and the time it was recorded at. */
+struct FKinematicSample
+{
+	FVector location; /** World location. */
+	FQuat rotation; /** World rotation. */
+	double time; /** Time since the history was last reset. */
+};
+
+/** Fixed size history of the transforms of a moving object, recorded once per frame. Used to get velocities that are fitted across a
+ * window of frames instead of the noisy difference between the last two, and the peak velocity over a window for throwing.
+ * NOTE: Never allocates, the oldest sample is overwritten once full. No engine state is used so recorded streams can be replayed through it. */
+class VRTEMPLATE_API FKinematicHistory
+{
+public:
+
+	/** Max number of samples stored. */
+	static const int32 capacity = 32;
+
+public:
+
+	/** Constructor. */
+	FKinematicHistory();
+
+	/** Record the latest transform.
+	 * @Param location, World location.
+	 * @Param rotation, World rotation.
+	 * @Param deltaTime, Time since the last sample. */
+	void AddSample(const FVector& location, const FQuat& rotation, float deltaTime);
+
+	/** Clear the history. Call when the object is teleported so the jump isn't seen as velocity. */
+	void Reset();
+
+	/** @Return the number of stored samples. */
+	int32 Num() const { return numSamples; }
+
+	/** @Return the sample the given number of samples before the newest, 0 is the newest. Must be less than Num(). */
+	const FKinematicSample& GetSample(int32 age) const;
+
+	/** Least squares fit of the linear velocity over the samples within the window.
+	 * @Param window, Time back from the newest sample to use.
+	 * @Return Velocity in units per second, zero if there are not enough samples. */
+	FVector GetLinearVelocity(float window) const;
+
+	/** Least squares fit of the angular velocity over the samples within the window.
+	 * @Param window, Time back from the newest sample to use.
+	 * @Return World space axis scaled by the speed in radians per second, zero if there are not enough samples. */
+	FVector GetAngularVelocity(float window) const;
+
+	/** Fastest velocity between two consecutive samples within the window. Used for the release velocity of thrown objects.
+	 * @Param window, Time back from the newest sample to use.
+	 * @Return Velocity in units per second, zero if there are not enough samples. */
+	FVector GetPeakLinearVelocity(float window) const;
+
+	/** Least squares fit of the rate of change in speed over the samples within the window.
+	 * @Param window, Time back from the newest sample to use.
+	 * @Return Change in speed in units per second squared, zero if there are not enough samples. */
+	float GetSpeedChange(float window) const;
+
+private:
+
+	FKinematicSample samples[capacity]; /** Ring buffer of samples. */
+	int32 newestSample; /** Index of the newest sample in the ring buffer. */
+	int32 numSamples; /** Number of valid samples. */
+
+private:
+
+	/** @Return the number of samples within the window back from the newest sample, at least 2 if there are 2 samples. */
+	int32 NumInWindow(float window) const;
+};
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/LocomotionIntegrator.h"
+
+FLocomotionIntegrator::FLocomotionIntegrator()
+{
+	fixedStep = 1.0f / 120.0f;
+	maxSubsteps = 8;
+	maxSpeed = 150.0f;
+	acceleration = 4000.0f;
+	deceleration = 8000.0f;
+	Reset();
+}
+
+FVector FLocomotionIntegrator::Advance(float deltaTime, const FVector& input)
+{
+	const double step = FMath::Max(fixedStep, KINDA_SMALL_NUMBER);
+	accumulator += FMath::Max(deltaTime, 0.0f);
+
+	// Drop any time over the max substeps.
+	int32 numSteps = FMath::FloorToInt(accumulator / step);
+	if (numSteps > maxSubsteps)
+	{
+		accumulator -= (numSteps - maxSubsteps) * step;
+		numSteps = FMath::Max(maxSubsteps, 0);
+	}
+
+	// Run the steps.
+	for (int32 i = 0; i < numSteps; i++)
+	{
+		previousPosition = currentPosition;
+		Step(input);
+		accumulator -= step;
+	}
+
+	// Interpolate into the next step by the time left over, then move the origin to the returned position to keep the values small.
+	const FVector movement = FMath::Lerp(previousPosition, currentPosition, (float)FMath::Clamp(accumulator / step, 0.0, 1.0));
+	previousPosition -= movement;
+	currentPosition -= movement;
+	return movement;
+}
+
+void FLocomotionIntegrator::Step(const FVector& input)
+{
+	// Accelerate towards the input velocity, or decelerate to a stop if there is none.
+	const FVector clampedInput = input.GetClampedToMaxSize(1.0f);
+	if (clampedInput.IsNearlyZero()) velocity = FMath::VInterpConstantTo(velocity, FVector::ZeroVector, fixedStep, deceleration);
+	else velocity = FMath::VInterpConstantTo(velocity, clampedInput * maxSpeed, fixedStep, acceleration);
+	currentPosition += velocity * fixedStep;
+}
+
+void FLocomotionIntegrator::ClipVelocity(const FVector& normal)
+{
+	const float intoSurface = velocity | normal;
+	if (intoSurface < 0.0f) velocity -= normal * intoSurface;
+}
+
+void FLocomotionIntegrator::Reset()
+{
+	velocity = FVector::ZeroVector;
+	previousPosition = FVector::ZeroVector;
+	currentPosition = FVector::ZeroVector;
+	accumulator = 0.0;
+}
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+/** Fixed timestep integrator for continuous locomotion. Each frame the elapsed time is split into fixed steps, capped so a hitch can't
+ * move the player further than the max substeps allow, and the returned movement is interpolated between the last two steps. This makes
+ * the path of the player a function of time and input only, the same at any frame rate, and gives a single move to sweep per frame. */
+class VRTEMPLATE_API FLocomotionIntegrator
+{
+public:
+
+	/** Time of each step. */
+	float fixedStep;
+
+	/** Max steps ran in a single frame, any more time is dropped. */
+	int32 maxSubsteps;
+
+	/** Speed at full input. */
+	float maxSpeed;
+
+	/** Change in speed per second towards the input velocity. */
+	float acceleration;
+
+	/** Change in speed per second towards stopping when there is no input. */
+	float deceleration;
+
+public:
+
+	/** Constructor. */
+	FLocomotionIntegrator();
+
+	/** Advance the simulation by the frame time.
+	 * @Param deltaTime, Time since the last frame.
+	 * @Param input, Desired movement as a fraction of the max speed, clamped to a size of 1.
+	 * @Return the movement to apply this frame. */
+	FVector Advance(float deltaTime, const FVector& input);
+
+	/** Remove any velocity into a surface that was hit while applying the movement.
+	 * @Param normal, The normal of the surface. */
+	void ClipVelocity(const FVector& normal);
+
+	/** Stop and clear any time left over from the last frame. */
+	void Reset();
+
+private:
+
+	FVector velocity; /** Velocity of the latest step. */
+	FVector previousPosition; /** Position after the step before the latest, relative to the last returned position. */
+	FVector currentPosition; /** Position after the latest step, relative to the last returned position. */
+	double accumulator; /** Time not yet stepped. */
+
+private:
+
+	/** Run a single fixed step. */
+	void Step(const FVector& input);
+};
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/MockHandleBackend.h"
+#include "Player/VRPhysicsHandleComponent.h"
+#include "Components/PrimitiveComponent.h"
+
+bool FMockHandleBackend::IsValidJoint(int32 joint) const
+{
+	return joints.IsValidIndex(joint) && joints[joint].inUse;
+}
+
+FVector FMockHandleBackend::SpringStep(const FVector& error, FVector& velocity, float stiffness, float damping, float maxAcceleration, float deltaTime)
+{
+	// Solve for the velocity at the end of the step so stiff springs don't explode.
+	const FVector newVelocity = (velocity + error * (stiffness * deltaTime)) / (1.0f + damping * deltaTime + stiffness * deltaTime * deltaTime);
+	FVector acceleration = (newVelocity - velocity) / deltaTime;
+	if (maxAcceleration > 0.0f) acceleration = acceleration.GetClampedToMaxSize(maxAcceleration);
+	velocity += acceleration * deltaTime;
+	return velocity * deltaTime;
+}
+
+int32 FMockHandleBackend::CreateJoint(UPrimitiveComponent* comp, FName boneName, const FTransform& jointPose)
+{
+	if (!comp) return INDEX_NONE;
+
+	// Reuse a free slot if there is one.
+	int32 index = joints.IndexOfByPredicate([](const FMockJoint& joint) { return !joint.inUse; });
+	if (index == INDEX_NONE) index = joints.AddDefaulted();
+
+	// Start at rest with every axis free until setup.
+	FMockJoint& joint = joints[index];
+	FTransform compTransform = comp->GetComponentTransform();
+	compTransform.RemoveScaling();
+	joint.component = comp;
+	joint.localFrame = jointPose.GetRelativeTransform(compTransform);
+	joint.target = jointPose;
+	joint.linearVelocity = FVector::ZeroVector;
+	joint.angularVelocity = FVector::ZeroVector;
+	joint.linearStiffness = joint.linearDamping = joint.maxLinearAcceleration = 0.0f;
+	joint.angularStiffness = joint.angularDamping = joint.maxAngularAcceleration = 0.0f;
+	joint.linearLocked = false;
+	joint.angularLocked = false;
+	joint.rotationConstraint = false;
+	joint.inUse = true;
+	return index;
+}
+
+void FMockHandleBackend::DestroyJoint(int32 joint)
+{
+	RETURN(!IsValidJoint(joint));
+	joints[joint].inUse = false;
+	joints[joint].component = nullptr;
+}
+
+void FMockHandleBackend::SetupJoint(int32 joint, const FPhysicsHandleData& data, bool rotationConstraint)
+{
+	RETURN(!IsValidJoint(joint));
+	FMockJoint& mockJoint = joints[joint];
+
+	// Match the PhysX joints motions and acceleration drives.
+	mockJoint.linearLocked = !data.softLinearConstraint;
+	mockJoint.linearStiffness = data.softLinearConstraint ? data.linearStiffness : 0.0f;
+	mockJoint.linearDamping = data.softLinearConstraint ? data.linearDamping : 0.0f;
+	mockJoint.maxLinearAcceleration = data.softLinearConstraint ? data.maxLinearForce : 0.0f;
+	mockJoint.rotationConstraint = rotationConstraint;
+	mockJoint.angularLocked = rotationConstraint && !data.softAngularConstraint;
+	mockJoint.angularStiffness = rotationConstraint && data.softAngularConstraint ? data.angularStiffness : 0.0f;
+	mockJoint.angularDamping = rotationConstraint && data.softAngularConstraint ? data.angularDamping : 0.0f;
+	mockJoint.maxAngularAcceleration = rotationConstraint && data.softAngularConstraint ? data.maxAngularForce : 0.0f;
+}
+
+void FMockHandleBackend::ExecuteWrite(TFunctionRef<void()> callable)
+{
+	// No scene to lock.
+	callable();
+}
+
+FTransform FMockHandleBackend::GetTargetPose_AssumesLocked(int32 joint) const
+{
+	return IsValidJoint(joint) ? joints[joint].target : FTransform::Identity;
+}
+
+void FMockHandleBackend::SetTargetPose_AssumesLocked(int32 joint, const FTransform& pose)
+{
+	if (IsValidJoint(joint)) joints[joint].target = pose;
+}
+
+void FMockHandleBackend::Step(float deltaTime)
+{
+	RETURN(deltaTime <= SMALL_NUMBER);
+	for (FMockJoint& joint : joints)
+	{
+		if (!joint.inUse || !joint.component.IsValid()) continue;
+		UPrimitiveComponent* comp = joint.component.Get();
+		FTransform compTransform = comp->GetComponentTransform();
+		compTransform.RemoveScaling();
+		const FTransform jointTransform = joint.localFrame * compTransform;
+
+		// Move the joint towards the target location.
+		FVector location = jointTransform.GetLocation();
+		if (joint.linearLocked)
+		{
+			joint.linearVelocity = (joint.target.GetLocation() - location) / deltaTime;
+			location = joint.target.GetLocation();
+		}
+		else location += SpringStep(joint.target.GetLocation() - location, joint.linearVelocity, joint.linearStiffness, joint.linearDamping, joint.maxLinearAcceleration, deltaTime);
+
+		// Rotate the joint towards the target rotation if constrained.
+		FQuat rotation = jointTransform.GetRotation();
+		if (joint.angularLocked) rotation = joint.target.GetRotation();
+		else if (joint.rotationConstraint)
+		{
+			FQuat error = joint.target.GetRotation() * rotation.Inverse();
+			if (error.W < 0.0f) error = error * -1.0f;
+			FVector axis;
+			float angle;
+			error.ToAxisAndAngle(axis, angle);
+			const FVector rotated = SpringStep(axis * angle, joint.angularVelocity, joint.angularStiffness, joint.angularDamping, joint.maxAngularAcceleration, deltaTime);
+			const float rotatedAngle = rotated.Size();
+			if (rotatedAngle > SMALL_NUMBER) rotation = FQuat(rotated / rotatedAngle, rotatedAngle) * rotation;
+			rotation.Normalize();
+		}
+
+		// Move the component so the joint is at its new transform.
+		const FTransform newCompTransform = joint.localFrame.Inverse() * FTransform(rotation, location);
+		comp->SetWorldLocationAndRotation(newCompTransform.GetLocation(), newCompTransform.GetRotation(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
+
+int32 FMockHandleBackend::GetNumActiveJoints() const
+{
+	int32 count = 0;
+	for (const FMockJoint& joint : joints) if (joint.inUse) count++;
+	return count;
+}
+
+void FMockHandleBackend::Release()
+{
+	// Nothing is added to a scene, drop the unused slots.
+	while (joints.Num() > 0 && !joints.Last().inUse) joints.Pop(false);
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Project/HandlePhysicsBackend.h"
+
+/** CPU physics handle backend that needs no physics scene. Each joint drives the grabbed component towards its target with an implicit spring
+ * damper using the handles drive values, locked axes snap straight to the target, and the component is moved directly. Used to run the grab,
+ * release and drag code in automation tests and micro-benchmarks on a headless build.
+ * NOTE: Collision is ignored, grabbed components pass through everything. */
+class VRTEMPLATE_API FMockHandleBackend : public IHandlePhysicsBackend
+{
+private:
+
+	/** A simulated joint and the component it drives. */
+	struct FMockJoint
+	{
+		TWeakObjectPtr<UPrimitiveComponent> component; /** The grabbed component. */
+		FTransform localFrame; /** The joint relative to the grabbed component. */
+		FTransform target; /** Pose of the kinematic target. */
+		FVector linearVelocity; /** Velocity of the joint. */
+		FVector angularVelocity; /** Angular velocity of the joint, as an axis scaled by radians per second. */
+		float linearStiffness, linearDamping, maxLinearAcceleration; /** Linear drive, zero stiffness if locked. */
+		float angularStiffness, angularDamping, maxAngularAcceleration; /** Angular drive, zero stiffness if locked. */
+		bool linearLocked; /** Snap the location to the target. */
+		bool angularLocked; /** Snap the rotation to the target. */
+		bool rotationConstraint; /** Is the rotation driven at all. */
+		bool inUse; /** Is this slot currently used. */
+	};
+
+	TArray<FMockJoint> joints; /** Every joint slot, indexed by joint id. */
+
+private:
+
+	/** @Return true if the id refers to a joint in use. */
+	bool IsValidJoint(int32 joint) const;
+
+public:
+
+	/** Move a value towards zero error with an implicit spring damper, stable for any stiffness and time step.
+	 * @Param error, Distance from the target.
+	 * @Param velocity, Current velocity, updated.
+	 * @Param stiffness, Spring stiffness.
+	 * @Param damping, Damping.
+	 * @Param maxAcceleration, Max change in velocity per second, zero for no limit.
+	 * @Param deltaTime, The time step.
+	 * @Return the distance moved. */
+	static FVector SpringStep(const FVector& error, FVector& velocity, float stiffness, float damping, float maxAcceleration, float deltaTime);
+
+	/** Implementation of the backend interface. */
+	virtual int32 CreateJoint(UPrimitiveComponent* comp, FName boneName, const FTransform& jointPose) override;
+	virtual void DestroyJoint(int32 joint) override;
+	virtual void SetupJoint(int32 joint, const FPhysicsHandleData& data, bool rotationConstraint) override;
+	virtual void ExecuteWrite(TFunctionRef<void()> callable) override;
+	virtual FTransform GetTargetPose_AssumesLocked(int32 joint) const override;
+	virtual void SetTargetPose_AssumesLocked(int32 joint, const FTransform& pose) override;
+	virtual void Step(float deltaTime) override;
+	virtual int32 GetNumActiveJoints() const override;
+	virtual void Release() override;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/NavMeshWalker.h"
+
+#if WITH_RECAST
+#include "Detour/DetourNavMeshQuery.h"
+#include "NavMesh/RecastHelpers.h"
+
+/** Max polygons a single move can cross. */
+static const int32 maxVisitedPolys = 16;
+
+FNavMeshWalker::FNavMeshWalker()
+{
+	mesh = nullptr;
+	query = nullptr;
+	polyRef = 0;
+	location = FVector::ZeroVector;
+	located = false;
+}
+
+FNavMeshWalker::~FNavMeshWalker()
+{
+	if (query) dtFreeNavMeshQuery(query);
+}
+
+bool FNavMeshWalker::Init(const dtNavMesh* navMesh)
+{
+	if (!navMesh) return false;
+	if (navMesh == mesh && query) return true;
+
+	// Moves only visit a few polygons so the node pool is small.
+	if (!query) query = dtAllocNavMeshQuery();
+	if (!query || dtStatusFailed(query->init(navMesh, maxVisitedPolys * 4)))
+	{
+		mesh = nullptr;
+		return false;
+	}
+	mesh = navMesh;
+	Reset();
+	return true;
+}
+
+bool FNavMeshWalker::Place(const FVector& newLocation, const FVector& extent, const dtQueryFilter* filter)
+{
+	if (!mesh || !filter) return false;
+
+	// Find the nearest polygon, detour swaps the Y and Z axes.
+	const FVector recastLocation = Unreal2RecastPoint(newLocation);
+	const FVector recastExtent = FVector(extent.X, extent.Z, extent.Y);
+	float nearestPoint[3];
+	dtPolyRef nearestRef = 0;
+	if (dtStatusFailed(query->findNearestPoly(&recastLocation.X, &recastExtent.X, filter, &nearestRef, nearestPoint)) || nearestRef == 0)
+	{
+		polyRef = 0;
+		return false;
+	}
+	polyRef = nearestRef;
+	location = Recast2UnrealPoint(nearestPoint);
+	located = true;
+	return true;
+}
+
+bool FNavMeshWalker::Move(const FVector& target, const dtQueryFilter* filter)
+{
+	if (!IsPlaced() || !filter) return false;
+
+	// Move along the surface from the current polygon, sliding along any edges hit.
+	const FVector recastStart = Unreal2RecastPoint(location);
+	const FVector recastTarget = Unreal2RecastPoint(target);
+	float resultPoint[3];
+	dtPolyRef visited[maxVisitedPolys];
+	int visitedCount = 0;
+	if (dtStatusFailed(query->moveAlongSurface(polyRef, &recastStart.X, &recastTarget.X, filter, resultPoint, visited, &visitedCount, maxVisitedPolys)) || visitedCount == 0) return false;
+
+	// The last polygon visited is the one the point ends on, move the point onto its surface.
+	polyRef = visited[visitedCount - 1];
+	float height = resultPoint[1];
+	if (dtStatusSucceed(query->getPolyHeight(polyRef, resultPoint, &height))) resultPoint[1] = height;
+	location = Recast2UnrealPoint(resultPoint);
+	return true;
+}
+
+void FNavMeshWalker::Reset()
+{
+	polyRef = 0;
+	located = false;
+}
+
+bool FNavMeshWalker::IsPlaced() const
+{
+	return mesh && polyRef != 0 && mesh->isValidPolyRef(polyRef);
+}
+#endif
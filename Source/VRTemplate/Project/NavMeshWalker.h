@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+
+#if WITH_RECAST
+#include "Detour/DetourNavMesh.h"
+
+/** Declare classes used. */
+class dtNavMeshQuery;
+class dtQueryFilter;
+
+/** Keeps a point on a detour nav-mesh while it is moved, used to walk the player along the nav-mesh without any physics sweeps. The polygon
+ * the point is on is kept between moves so each move only visits the polygons it crosses, sliding along the edges of the nav-mesh. */
+class VRTEMPLATE_API FNavMeshWalker
+{
+public:
+
+	/** Constructor. */
+	FNavMeshWalker();
+
+	/** Destructor. */
+	~FNavMeshWalker();
+
+	/** Setup the walker for a nav-mesh, does nothing if already setup for it.
+	 * @Param navMesh, The nav-mesh to walk on.
+	 * @Return false if the query couldn't be created. */
+	bool Init(const dtNavMesh* navMesh);
+
+	/** Place the point on the nearest polygon to a location.
+	 * @Param location, The location in unreal space.
+	 * @Param extent, The extent to search for a polygon around the location.
+	 * @Param filter, The filter of polygons that can be walked on.
+	 * @Return false if there is no polygon within the extent. */
+	bool Place(const FVector& location, const FVector& extent, const dtQueryFilter* filter);
+
+	/** Move the point towards a target along the nav-mesh, stopping or sliding at its edges.
+	 * @Param target, The target location in unreal space.
+	 * @Param filter, The filter of polygons that can be walked on.
+	 * @Return false if not placed or the polygon no longer exists, the point must be placed again. */
+	bool Move(const FVector& target, const dtQueryFilter* filter);
+
+	/** Clear the placed point and its last location. */
+	void Reset();
+
+	/** @Return true if the point is on a polygon that still exists. */
+	bool IsPlaced() const;
+
+	/** @Return true if the point has been placed since it was last reset, its location is kept when the polygon it was on is rebuilt. */
+	bool HasLocation() const { return located; }
+
+	/** @Return the location of the point on the nav-mesh in unreal space. */
+	const FVector& GetLocation() const { return location; }
+
+private:
+
+	const dtNavMesh* mesh; /** The nav-mesh walked on. */
+	dtNavMeshQuery* query; /** Query for the nav-mesh. */
+	dtPolyRef polyRef; /** Polygon the point is on. */
+	FVector location; /** Location of the point in unreal space. */
+	bool located; /** Has the point been placed since it was last reset, its location is kept if the polygon is rebuilt. */
+
+private:
+
+	/** Not copyable as it owns the query. */
+	FNavMeshWalker(const FNavMeshWalker&) = delete;
+	FNavMeshWalker& operator=(const FNavMeshWalker&) = delete;
+};
+#endif
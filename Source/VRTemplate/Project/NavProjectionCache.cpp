@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/NavProjectionCache.h"
+#include "Project/WorldService.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY(LogNavProjectionCache);
+DECLARE_STATS_GROUP(TEXT("NavProjectionCache"), STATGROUP_NavProjectionCache, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cache Hits"), STAT_NavProjectionHits, STATGROUP_NavProjectionCache);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cache Misses"), STAT_NavProjectionMisses, STATGROUP_NavProjectionCache);
+
+ANavProjectionCache::ANavProjectionCache()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Initialise default variables.
+	cellSize = 5.0f;
+	maxCells = 4096;
+	hits = 0;
+	misses = 0;
+	invalidations = 0;
+	cachedExtent = FVector::ZeroVector;
+	navDataFound = false;
+	boundToNavSystem = false;
+
+#if WITH_EDITOR
+	debug = false;
+#endif
+}
+
+void ANavProjectionCache::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Remove cells as soon as the tiles under them are marked to be rebuilt.
+	navigationDirtyHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &ANavProjectionCache::OnNavigationDirtied);
+}
+
+void ANavProjectionCache::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+	UNavigationSystemV1::NavigationDirtyEvent.Remove(navigationDirtyHandle);
+}
+
+ANavProjectionCache* ANavProjectionCache::Get(UWorld* world)
+{
+	CHECK_RETURN_NULL(LogNavProjectionCache, !world, "ANavProjectionCache::Get: Cannot get the nav projection cache of a null world.");
+
+	// Find or spawn the service.
+	ANavProjectionCache* service = GetWorldService<ANavProjectionCache>(world);
+	CHECK_RETURN_NULL(LogNavProjectionCache, !service, "ANavProjectionCache::Get: Failed to spawn the nav projection cache.");
+	return service;
+}
+
+ANavigationData* ANavProjectionCache::GetNavData(const FNavAgentProperties& props)
+{
+	// Use the cached nav data if its for the same agent.
+	if (navDataFound && agentProps.IsEquivalent(props) && navData.IsValid()) return navData.Get();
+
+	UNavigationSystemV1* navSystem = Cast<UNavigationSystemV1>(GetWorld()->GetNavigationSystem());
+	if (!navSystem) return nullptr;
+
+	// Look up the nav data again when the nav-mesh is rebuilt.
+	if (!boundToNavSystem)
+	{
+		navSystem->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &ANavProjectionCache::OnNavigationGenerationFinished);
+		boundToNavSystem = true;
+	}
+
+	// Projections from another agent or nav data are no longer valid.
+	ANavigationData* agentNavData = navSystem->GetNavDataForProps(props);
+	if (agentNavData != navData.Get() || !agentProps.IsEquivalent(props)) Invalidate();
+	agentProps = props;
+	navData = agentNavData;
+	navDataFound = true;
+	return agentNavData;
+}
+
+bool ANavProjectionCache::ProjectPoint(const FNavAgentProperties& props, const FVector& location, const FVector& extent, FVector& outLocation)
+{
+	ANavigationData* agentNavData = GetNavData(props);
+	if (!agentNavData) return false;
+
+	// Cells filled with another extent can give different results.
+	if (!extent.Equals(cachedExtent))
+	{
+		Invalidate();
+		cachedExtent = extent;
+	}
+
+	// Don't remember anything while the nav-mesh is being rebuilt as it will be cleared once finished.
+	UNavigationSystemV1* navSystem = Cast<UNavigationSystemV1>(GetWorld()->GetNavigationSystem());
+	const bool canCache = navSystem && !navSystem->IsNavigationBuildInProgress();
+
+	// Use the remembered projection for the cell if there is one.
+	const FIntVector cell = FIntVector(FMath::FloorToInt(location.X / cellSize), FMath::FloorToInt(location.Y / cellSize), FMath::FloorToInt(location.Z / cellSize));
+	if (canCache)
+	{
+		if (const FCachedProjection* cached = cells.Find(cell))
+		{
+			hits++;
+			INC_DWORD_STAT(STAT_NavProjectionHits);
+			if (cached->onNav) outLocation = cached->location;
+			return cached->onNav;
+		}
+	}
+
+	// Otherwise project onto the nav-mesh.
+	misses++;
+	INC_DWORD_STAT(STAT_NavProjectionMisses);
+	FNavLocation navLocation;
+	const bool onNav = agentNavData->ProjectPoint(location, navLocation, extent);
+	if (onNav) outLocation = navLocation.Location;
+
+	// Remember the result, starting again when full.
+	if (canCache)
+	{
+		if (cells.Num() >= maxCells) Invalidate();
+		FCachedProjection& newCell = cells.Add(cell);
+		newCell.location = onNav ? navLocation.Location : location;
+		newCell.onNav = onNav;
+	}
+	return onNav;
+}
+
+void ANavProjectionCache::Invalidate()
+{
+	if (cells.Num() > 0)
+	{
+		invalidations++;
+
+#if WITH_EDITOR && DEVELOPMENT
+		if (debug) UE_LOG(LogNavProjectionCache, Log, TEXT("Cleared %d cached nav projections, hit rate %f."), cells.Num(), GetHitRate());
+#endif
+	}
+
+	// Keep the memory as the cache will be filled again.
+	cells.Reset();
+}
+
+void ANavProjectionCache::InvalidateArea(const FBox& bounds)
+{
+	RETURN(cells.Num() == 0 || !bounds.IsValid);
+
+	// Any point within the query extent of the area could have been projected onto it.
+	const FBox affected = bounds.ExpandBy(cachedExtent + FVector(cellSize));
+	int32 removed = 0;
+	for (auto it = cells.CreateIterator(); it; ++it)
+	{
+		const FVector cellCenter = (FVector(it.Key()) + FVector(0.5f)) * cellSize;
+		if (affected.IsInsideOrOn(cellCenter))
+		{
+			it.RemoveCurrent();
+			removed++;
+		}
+	}
+	if (removed > 0) invalidations++;
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug && removed > 0) UE_LOG(LogNavProjectionCache, Log, TEXT("Cleared %d cached nav projections in a rebuilt area, hit rate %f."), removed, GetHitRate());
+#endif
+}
+
+void ANavProjectionCache::OnNavigationDirtied(const FBox& dirtyBounds)
+{
+	InvalidateArea(dirtyBounds);
+}
+
+void ANavProjectionCache::OnNavigationGenerationFinished(ANavigationData* updatedNavData)
+{
+	// The nav data may have been replaced so look it up again next time, cells are only cleared if it has.
+	navDataFound = false;
+}
+
+float ANavProjectionCache::GetHitRate() const
+{
+	const int total = hits + misses;
+	return total > 0 ? (float)hits / total : 0.0f;
+}
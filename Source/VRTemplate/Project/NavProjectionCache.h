@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Globals.h"
+#include "NavProjectionCache.generated.h"
+
+/** Define this actors log category. */
+DECLARE_LOG_CATEGORY_EXTERN(LogNavProjectionCache, Log, All);
+
+/** Declare classes used. */
+class ANavigationData;
+
+/** World level service to project points onto the nav-mesh, used to validate teleport locations while aiming. The nav data for the agent is
+ * looked up once and each projection is remembered in a spatial hash of small cells, so aiming at the same area again doesn't query the
+ * nav-mesh. Cells in an area of the nav-mesh that is marked dirty for its tiles to be rebuilt are removed, and the cache is bypassed while
+ * the nav-mesh is being rebuilt.
+ * NOTE: Spawned on demand through Get(), there should only ever be one per world. */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class VRTEMPLATE_API ANavProjectionCache : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Size of each cell in the spatial hash. Points in the same cell share a projection so this is the max error of a cached result. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NavProjection", meta = (ClampMin = "0.1", UIMin = "1.0", UIMax = "20.0"))
+	float cellSize;
+
+	/** Max number of cells to remember, the cache is cleared when full. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NavProjection", meta = (ClampMin = "1"))
+	int maxCells;
+
+	/** Number of projections answered from the cache. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NavProjection|Stats")
+	int hits;
+
+	/** Number of projections that had to query the nav-mesh. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NavProjection|Stats")
+	int misses;
+
+	/** Number of times the cache, or an area of it, has been cleared. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NavProjection|Stats")
+	int invalidations;
+
+	/** Enable any debug messages for this class.
+	 * NOTE: Only used when DEVELOPMENT = 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NavProjection")
+	bool debug;
+
+private:
+
+	/** A remembered projection. */
+	struct FCachedProjection
+	{
+		FVector location; /** The projected point, a point on the nav-mesh even if the cell crosses an edge of it. */
+		bool onNav; /** Was the point on the nav-mesh. */
+	};
+
+	TMap<FIntVector, FCachedProjection> cells; /** Remembered projections by quantized location. */
+	TWeakObjectPtr<ANavigationData> navData; /** Nav data of the cached agent. */
+	FNavAgentProperties agentProps; /** Agent the nav data was found for. */
+	FVector cachedExtent; /** Query extent the cells were filled with. */
+	bool navDataFound; /** Has the nav data been looked up for the agent. */
+	bool boundToNavSystem; /** Is the nav system rebuild delegate bound. */
+	FDelegateHandle navigationDirtyHandle; /** Handle to the nav systems navigation dirty event. */
+
+private:
+
+	/** Find and cache the nav data for the agent, binding to the nav system if not already. */
+	ANavigationData* GetNavData(const FNavAgentProperties& props);
+
+	/** Called by the nav system when the nav-mesh has finished building. */
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* updatedNavData);
+
+	/** Called by the nav system when an area is marked dirty and the nav-mesh tiles in it will be rebuilt. */
+	void OnNavigationDirtied(const FBox& dirtyBounds);
+
+protected:
+
+	/** Level start. */
+	virtual void BeginPlay() override;
+
+	/** Level end or destroyed. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Constructor. */
+	ANavProjectionCache();
+
+	/** Get the nav projection cache for the given world, spawning one if it doesn't exist yet.
+	 * @Param world, The world to get the service for. */
+	static ANavProjectionCache* Get(UWorld* world);
+
+	/** Project a point onto the nav-mesh of the given agent.
+	 * @Param props, The agent to use the nav-mesh of.
+	 * @Param location, The point to project.
+	 * @Param extent, The extent to search around the point.
+	 * @Param outLocation, The projected point if on the nav-mesh.
+	 * @Return true if the point was projected onto the nav-mesh. */
+	bool ProjectPoint(const FNavAgentProperties& props, const FVector& location, const FVector& extent, FVector& outLocation);
+
+	/** Clear all remembered projections. */
+	UFUNCTION(BlueprintCallable, Category = "NavProjection")
+	void Invalidate();
+
+	/** Clear the remembered projections of any points that could have been projected onto the nav-mesh in the given area.
+	 * @Param bounds, The area of the nav-mesh that has changed. */
+	UFUNCTION(BlueprintCallable, Category = "NavProjection")
+	void InvalidateArea(const FBox& bounds);
+
+	/** @Return the fraction of projections answered from the cache. */
+	UFUNCTION(BlueprintPure, Category = "NavProjection")
+	float GetHitRate() const;
+};
@@ -0,0 +1,283 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/PhysXHandleBackend.h"
+#include "Project/PhysicsHandleManager.h"
+#include "Player/VRPhysicsHandleComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "PhysicsPublic.h"
+#include "PhysXIncludes.h"
+#include "Engine/World.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+
+#if WITH_PHYSX
+#include "PhysXPublic.h"
+#endif
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Joints"), STAT_PhysicsHandlePooledJoints, STATGROUP_PhysicsHandleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Joints Created"), STAT_PhysicsHandleJointsCreated, STATGROUP_PhysicsHandleManager);
+
+FPhysXHandleBackend::FPhysXHandleBackend(UWorld* inWorld, int32 poolSize, int32 inMaxPoolSize)
+{
+	world = inWorld;
+	maxPoolSize = inMaxPoolSize;
+	released = false;
+
+	// Add the pooled targets and joints to the scene now so the first grabs don't have to.
+#if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
+	FPhysScene* physScene = inWorld ? inWorld->GetPhysicsScene() : nullptr;
+	if (!physScene || poolSize <= 0) return;
+	FPhysicsCommand::ExecuteWrite(physScene, [&]()
+	{
+		if (PxScene* scene = physScene->GetPxScene())
+		{
+			for (int32 i = 0; i < poolSize; i++) AddPooledJoint_AssumesLocked(scene, PxTransform(PxIdentity));
+		}
+	});
+#endif
+}
+
+int32 FPhysXHandleBackend::AddPooledJoint_AssumesLocked(physx::PxScene* scene, const physx::PxTransform& pose, int32 index)
+{
+#if WITH_PHYSX
+	// Create kinematic actor to attach the joint to. This will be moved around with calls to SetLocation/SetRotation.
+	PxRigidDynamic* newTarget = scene->getPhysics().createRigidDynamic(pose);
+	if (!newTarget) return INDEX_NONE;
+	newTarget->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
+	newTarget->setMass(1.0f);
+	newTarget->setMassSpaceInertiaTensor(PxVec3(1.0f, 1.0f, 1.0f));
+	newTarget->userData = NULL;
+	scene->addActor(*newTarget);
+
+	// Create the joint attached to the world until it is used.
+	PxD6Joint* newJoint = PxD6JointCreate(scene->getPhysics(), newTarget, PxTransform(PxIdentity), nullptr, pose);
+	if (!newJoint)
+	{
+		newTarget->release();
+		return INDEX_NONE;
+	}
+	newJoint->userData = NULL;
+	ResetJoint(newJoint, newTarget);
+	INC_DWORD_STAT(STAT_PhysicsHandlePooledJoints);
+	INC_DWORD_STAT(STAT_PhysicsHandleJointsCreated);
+
+	// Add to the pool.
+	if (index == INDEX_NONE) index = jointPool.AddUninitialized();
+	FPooledJoint& pooled = jointPool[index];
+	pooled.scene = scene;
+	pooled.target = newTarget;
+	pooled.joint = newJoint;
+	pooled.inUse = false;
+	return index;
+#else
+	return INDEX_NONE;
+#endif
+}
+
+void FPhysXHandleBackend::ResetJoint(physx::PxD6Joint* joint, physx::PxRigidDynamic* target)
+{
+#if WITH_PHYSX
+	// Attach to the world and free every axis so the joint does nothing.
+	joint->setActors(target, nullptr);
+	joint->setMotion(PxD6Axis::eX, PxD6Motion::eFREE);
+	joint->setMotion(PxD6Axis::eY, PxD6Motion::eFREE);
+	joint->setMotion(PxD6Axis::eZ, PxD6Motion::eFREE);
+	joint->setMotion(PxD6Axis::eTWIST, PxD6Motion::eFREE);
+	joint->setMotion(PxD6Axis::eSWING1, PxD6Motion::eFREE);
+	joint->setMotion(PxD6Axis::eSWING2, PxD6Motion::eFREE);
+
+	// Clear any drives.
+	joint->setDrive(PxD6Drive::eX, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+	joint->setDrive(PxD6Drive::eY, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+	joint->setDrive(PxD6Drive::eZ, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+	joint->setDrive(PxD6Drive::eSLERP, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+#endif
+}
+
+bool FPhysXHandleBackend::IsValidJoint(int32 joint) const
+{
+	return jointPool.IsValidIndex(joint) && jointPool[joint].inUse && jointPool[joint].target;
+}
+
+int32 FPhysXHandleBackend::CreateJoint(UPrimitiveComponent* comp, FName boneName, const FTransform& jointPose)
+{
+	int32 index = INDEX_NONE;
+#if WITH_PHYSX && PHYSICS_INTERFACE_PHYSX
+	// Get the PxRigidDynamic that we want to grab.
+	FBodyInstance* bodyInstance = comp ? comp->GetBodyInstance(boneName) : nullptr;
+	if (!bodyInstance) return INDEX_NONE;
+
+	FPhysicsCommand::ExecuteWrite(bodyInstance->GetPhysicsActorHandle(), [&](const FPhysicsActorHandle& actor)
+	{
+		PxRigidActor* grabbedActor = FPhysicsInterface::GetPxRigidActor_AssumesLocked(actor);
+		PxScene* scene = grabbedActor ? grabbedActor->getScene() : nullptr;
+		CHECK_RETURN(LogPhysicsHandleManager, !scene, "FPhysXHandleBackend::CreateJoint: The grabbed actor is not in a scene.");
+		const PxTransform pose = U2PTransform(jointPose);
+
+		// Find a free pooled joint in the same scene, creating one in a released slot or a new slot if there are none.
+		for (int32 i = 0; i < jointPool.Num(); i++)
+		{
+			if (!jointPool[i].inUse && jointPool[i].target && jointPool[i].scene == scene)
+			{
+				index = i;
+				break;
+			}
+		}
+		if (index == INDEX_NONE)
+		{
+			const int32 releasedSlot = jointPool.IndexOfByPredicate([](const FPooledJoint& pooled) { return pooled.target == nullptr; });
+			index = AddPooledJoint_AssumesLocked(scene, pose, releasedSlot);
+		}
+		CHECK_RETURN(LogPhysicsHandleManager, index == INDEX_NONE, "FPhysXHandleBackend::CreateJoint: Failed to create a joint.");
+
+		// Move the target to the joint pose without sweeping and attach the joint to the grabbed actor.
+		FPooledJoint& pooled = jointPool[index];
+		pooled.target->setGlobalPose(pose);
+		pooled.target->setKinematicTarget(pose);
+		pooled.joint->setActors(pooled.target, grabbedActor);
+		pooled.joint->setLocalPose(PxJointActorIndex::eACTOR0, PxTransform(PxIdentity));
+		pooled.joint->setLocalPose(PxJointActorIndex::eACTOR1, grabbedActor->getGlobalPose().transformInv(pose));
+		pooled.inUse = true;
+	});
+#endif
+	return index;
+}
+
+void FPhysXHandleBackend::DestroyJoint(int32 joint)
+{
+#if WITH_PHYSX
+	RETURN(!IsValidJoint(joint));
+	FPooledJoint& pooled = jointPool[joint];
+	SCOPED_SCENE_WRITE_LOCK(pooled.scene);
+
+	// Return to the pool if there is room.
+	int32 freeCount = 0;
+	for (const FPooledJoint& other : jointPool) if (!other.inUse && other.target) freeCount++;
+	pooled.inUse = false;
+	if (!released && freeCount < maxPoolSize)
+	{
+		ResetJoint(pooled.joint, pooled.target);
+		return;
+	}
+
+	// Otherwise remove from the scene, the slot is reused by the next joint created.
+	pooled.joint->release();
+	pooled.target->release();
+	pooled.joint = nullptr;
+	pooled.target = nullptr;
+	DEC_DWORD_STAT(STAT_PhysicsHandlePooledJoints);
+#endif
+}
+
+void FPhysXHandleBackend::SetupJoint(int32 joint, const FPhysicsHandleData& data, bool rotationConstraint)
+{
+#if WITH_PHYSX
+	RETURN(!IsValidJoint(joint));
+	PxD6Joint* pxJoint = jointPool[joint].joint;
+	SCOPED_SCENE_WRITE_LOCK(jointPool[joint].scene);
+
+	// Setup weather the constraint is soft or stiff.
+	PxD6Motion::Enum const LocationMotionType = data.softLinearConstraint ? PxD6Motion::eFREE : PxD6Motion::eLOCKED;
+	PxD6Motion::Enum const RotationMotionType = (data.softAngularConstraint || !rotationConstraint) ? PxD6Motion::eFREE : PxD6Motion::eLOCKED;
+
+	// Linear motion for handle.
+	pxJoint->setMotion(PxD6Axis::eX, LocationMotionType);
+	pxJoint->setMotion(PxD6Axis::eY, LocationMotionType);
+	pxJoint->setMotion(PxD6Axis::eZ, LocationMotionType);
+	pxJoint->setDrivePosition(PxTransform(PxVec3(0, 0, 0)));
+
+	// Angular motion for the handle.
+	pxJoint->setMotion(PxD6Axis::eTWIST, RotationMotionType);
+	pxJoint->setMotion(PxD6Axis::eSWING1, RotationMotionType);
+	pxJoint->setMotion(PxD6Axis::eSWING2, RotationMotionType);
+
+	// Setup Linear drives for this physics handle if created.
+	if (data.softLinearConstraint)
+	{
+		pxJoint->setDrive(PxD6Drive::eX, PxD6JointDrive(data.linearStiffness, data.linearDamping, data.maxLinearForce, PxD6JointDriveFlag::eACCELERATION));
+		pxJoint->setDrive(PxD6Drive::eY, PxD6JointDrive(data.linearStiffness, data.linearDamping, data.maxLinearForce, PxD6JointDriveFlag::eACCELERATION));
+		pxJoint->setDrive(PxD6Drive::eZ, PxD6JointDrive(data.linearStiffness, data.linearDamping, data.maxLinearForce, PxD6JointDriveFlag::eACCELERATION));
+	}
+	// Reset linear drives.
+	else
+	{
+		pxJoint->setDrive(PxD6Drive::eX, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+		pxJoint->setDrive(PxD6Drive::eY, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+		pxJoint->setDrive(PxD6Drive::eZ, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+	}
+
+	// Setup Angular drives for this physics handle if created.
+	if (rotationConstraint)
+	{
+		if (data.softAngularConstraint)
+		{
+			pxJoint->setDrive(PxD6Drive::eSLERP, PxD6JointDrive(data.angularStiffness, data.angularDamping, data.maxAngularForce, PxD6JointDriveFlag::eACCELERATION));
+		}
+		// Reset angular drive.
+		else
+		{
+			pxJoint->setDrive(PxD6Drive::eSLERP, PxD6JointDrive(0.0f, 0.0f, 0.0f, false));
+		}
+	}
+#endif
+}
+
+void FPhysXHandleBackend::ExecuteWrite(TFunctionRef<void()> callable)
+{
+#if WITH_PHYSX
+	FPhysScene* physScene = world.IsValid() ? world->GetPhysicsScene() : nullptr;
+	if (physScene) FPhysicsCommand::ExecuteWrite(physScene, callable);
+#endif
+}
+
+bool FPhysXHandleBackend::IsSubstepping() const
+{
+	// The substep callbacks are only ran by the worlds scene when substepping is enabled, otherwise the targets are moved once per frame.
+#if WITH_PHYSX
+	return world.IsValid() && world->GetPhysicsScene() && UPhysicsSettings::Get()->bSubstepping;
+#else
+	return false;
+#endif
+}
+
+FTransform FPhysXHandleBackend::GetTargetPose_AssumesLocked(int32 joint) const
+{
+#if WITH_PHYSX
+	if (IsValidJoint(joint)) return P2UTransform(jointPool[joint].target->getGlobalPose());
+#endif
+	return FTransform::Identity;
+}
+
+void FPhysXHandleBackend::SetTargetPose_AssumesLocked(int32 joint, const FTransform& pose)
+{
+#if WITH_PHYSX
+	if (IsValidJoint(joint)) jointPool[joint].target->setKinematicTarget(U2PTransform(pose));
+#endif
+}
+
+int32 FPhysXHandleBackend::GetNumActiveJoints() const
+{
+	int32 count = 0;
+	for (const FPooledJoint& pooled : jointPool) if (pooled.inUse) count++;
+	return count;
+}
+
+void FPhysXHandleBackend::Release()
+{
+	// Remove the unused pooled targets and joints from the scene, the ones still in use are removed when their handle destroys them.
+	released = true;
+#if WITH_PHYSX
+	ExecuteWrite([&]()
+	{
+		for (FPooledJoint& pooled : jointPool)
+		{
+			if (pooled.inUse || !pooled.target) continue;
+			pooled.joint->release();
+			pooled.target->release();
+			pooled.joint = nullptr;
+			pooled.target = nullptr;
+			DEC_DWORD_STAT(STAT_PhysicsHandlePooledJoints);
+		}
+	});
+#endif
+}
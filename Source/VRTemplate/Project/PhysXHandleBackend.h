@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Project/HandlePhysicsBackend.h"
+
+/** Declare classes used. */
+namespace physx
+{
+	class PxScene;
+	class PxRigidDynamic;
+	class PxD6Joint;
+	class PxTransform;
+}
+
+/** PhysX physics handle backend. Keeps a pool of kinematic target actors and D6 joints already added to the scene, so grabbing and releasing
+ * only re-points a joint instead of adding and removing actors from the scene. */
+class VRTEMPLATE_API FPhysXHandleBackend : public IHandlePhysicsBackend
+{
+private:
+
+	/** A kinematic target actor and the joint attached to it, kept in the scene between grabs. */
+	struct FPooledJoint
+	{
+		physx::PxScene* scene; /** The scene the target and joint are in. */
+		physx::PxRigidDynamic* target; /** Kinematic target actor, null if this slot has been released. */
+		physx::PxD6Joint* joint; /** Joint from the target actor to the grabbed actor, or the world when not in use. */
+		bool inUse; /** Is this entry currently used by a handle. */
+	};
+
+	TWeakObjectPtr<UWorld> world; /** The world whose physics scene is used. */
+	TArray<FPooledJoint> jointPool; /** Every pooled target and joint, indexed by joint id. */
+	int32 maxPoolSize; /** Max number of unused targets and joints to keep. */
+	bool released; /** Has the pool been released on end play, joints destroyed after this are removed from the scene. */
+
+private:
+
+	/** Create a kinematic target actor and a joint to the world at the given pose in the pool slot, adding a slot if index is INDEX_NONE.
+	 * NOTE: The scene must already be write locked.
+	 * @Return the index of the pool slot, INDEX_NONE if the joint could not be created. */
+	int32 AddPooledJoint_AssumesLocked(physx::PxScene* scene, const physx::PxTransform& pose, int32 index = INDEX_NONE);
+
+	/** Detach the joint from its grabbed actor and clear its motions and drives so it has no effect while in the pool. */
+	static void ResetJoint(physx::PxD6Joint* joint, physx::PxRigidDynamic* target);
+
+	/** @Return true if the id refers to a joint in use. */
+	bool IsValidJoint(int32 joint) const;
+
+public:
+
+	/** Constructor. Adds the pooled targets and joints to the worlds scene.
+	 * @Param inWorld, The world whose physics scene is used.
+	 * @Param poolSize, Number of targets and joints to create now.
+	 * @Param inMaxPoolSize, Max number of unused targets and joints to keep. */
+	FPhysXHandleBackend(UWorld* inWorld, int32 poolSize, int32 inMaxPoolSize);
+
+	/** Implementation of the backend interface. */
+	virtual int32 CreateJoint(UPrimitiveComponent* comp, FName boneName, const FTransform& jointPose) override;
+	virtual void DestroyJoint(int32 joint) override;
+	virtual void SetupJoint(int32 joint, const FPhysicsHandleData& data, bool rotationConstraint) override;
+	virtual void ExecuteWrite(TFunctionRef<void()> callable) override;
+	virtual FTransform GetTargetPose_AssumesLocked(int32 joint) const override;
+	virtual void SetTargetPose_AssumesLocked(int32 joint, const FTransform& pose) override;
+	virtual bool IsSubstepping() const override;
+	virtual int32 GetNumActiveJoints() const override;
+	virtual void Release() override;
+};
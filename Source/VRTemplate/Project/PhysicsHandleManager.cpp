@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/PhysicsHandleManager.h"
+#include "Project/WorldService.h"
+#include "Project/PhysXHandleBackend.h"
+#include "Project/MockHandleBackend.h"
+#include "Player/VRPhysicsHandleComponent.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY(LogPhysicsHandleManager);
+DECLARE_CYCLE_STAT(TEXT("Handle Smoothing"), STAT_PhysicsHandleSmoothing, STATGROUP_PhysicsHandleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Handles Updated"), STAT_PhysicsHandlesUpdated, STATGROUP_PhysicsHandleManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scene Writes"), STAT_PhysicsHandleSceneWrites, STATGROUP_PhysicsHandleManager);
+
+APhysicsHandleManager::APhysicsHandleManager()
+{
+	// Update before physics, the prerequisites added in RegisterHandle make sure this is after the hands.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+
+	// Initialise default variables.
+	backendType = EHandlePhysicsBackend::PhysX;
+	poolSize = 4;
+	maxPoolSize = 16;
+
+#if WITH_EDITOR
+	debug = false;
+#endif
+}
+
+APhysicsHandleManager* APhysicsHandleManager::Get(UWorld* world)
+{
+	CHECK_RETURN_NULL(LogPhysicsHandleManager, !world, "APhysicsHandleManager::Get: Cannot get the physics handle manager of a null world.");
+
+	// Find or spawn the service.
+	APhysicsHandleManager* service = GetWorldService<APhysicsHandleManager>(world);
+	CHECK_RETURN_NULL(LogPhysicsHandleManager, !service, "APhysicsHandleManager::Get: Failed to spawn the physics handle manager.");
+	return service;
+}
+
+void APhysicsHandleManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Create the backend now so the PhysX pool is filled before the first grabs.
+	GetBackend();
+}
+
+void APhysicsHandleManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Joints still in use are removed when their handle destroys them, so the backend is kept until the manager is destroyed.
+	if (backend.IsValid()) backend->Release();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+IHandlePhysicsBackend* APhysicsHandleManager::GetBackend()
+{
+	if (backend.IsValid()) return backend.Get();
+
+	// Use the mock if there is no physics scene to create joints in.
+	if (backendType == EHandlePhysicsBackend::PhysX && (!WITH_PHYSX || !GetWorld()->GetPhysicsScene())) backendType = EHandlePhysicsBackend::Mock;
+	if (backendType == EHandlePhysicsBackend::PhysX) backend = MakeUnique<FPhysXHandleBackend>(GetWorld(), poolSize, maxPoolSize);
+	else backend = MakeUnique<FMockHandleBackend>();
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug) UE_LOG(LogPhysicsHandleManager, Log, TEXT("Created the %s physics handle backend."), backendType == EHandlePhysicsBackend::PhysX ? TEXT("PhysX") : TEXT("mock"));
+#endif
+	return backend.Get();
+}
+
+bool APhysicsHandleManager::SetBackend(EHandlePhysicsBackend newBackend)
+{
+	// Handles hold ids into the current backend.
+	CHECK_RETURN_FALSE(LogPhysicsHandleManager, backend.IsValid() && backend->GetNumActiveJoints() > 0, "APhysicsHandleManager::SetBackend: Cannot change the backend while joints exist.");
+	if (backend.IsValid()) backend->Release();
+	backend.Reset();
+	backendType = newBackend;
+	GetBackend();
+	return true;
+}
+
+void APhysicsHandleManager::RegisterHandle(UVRPhysicsHandleComponent* handle)
+{
+	CHECK_RETURN(LogPhysicsHandleManager, !handle, "APhysicsHandleManager::RegisterHandle: Cannot register a null handle.");
+	handles.AddUnique(handle);
+	AddTickPrerequisites(handle->GetOwner());
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug) UE_LOG(LogPhysicsHandleManager, Log, TEXT("Registered the physics handle %s, %d handles registered."), *handle->GetName(), handles.Num());
+#endif
+}
+
+void APhysicsHandleManager::UnregisterHandle(UVRPhysicsHandleComponent* handle)
+{
+	handles.RemoveSwap(handle);
+}
+
+void APhysicsHandleManager::AddTickPrerequisites(AActor* actor)
+{
+	// Tick after the actor and whatever its attached to, the hands are updated from the pawn they are attached to.
+	for (AActor* current = actor; current; current = current->GetAttachParentActor())
+	{
+		if (current != this) AddTickPrerequisiteActor(current);
+	}
+}
+
+void APhysicsHandleManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Find the grabbing handles.
+	activeHandles.Reset();
+	for (int32 i = handles.Num() - 1; i >= 0; i--)
+	{
+		UVRPhysicsHandleComponent* handle = handles[i];
+		if (!handle || handle->IsPendingKill())
+		{
+			handles.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+		if (handle->IsJointActive()) activeHandles.Add(handle);
+	}
+	IHandlePhysicsBackend* currentBackend = GetBackend();
+	if (activeHandles.Num() > 0)
+	{
+		// Work out the new target of each grabbing handle on the game thread, handles using substeps are moved from the physics scene.
+		applyHandles.Reset();
+		{
+			SCOPE_CYCLE_COUNTER(STAT_PhysicsHandleSmoothing);
+			for (UVRPhysicsHandleComponent* handle : activeHandles)
+			{
+				handle->UpdateTarget(DeltaTime);
+				if (!handle->UsingSubsteps()) applyHandles.Add(handle);
+			}
+		}
+
+		// Apply every target inside one write lock of the worlds physics scene.
+		if (applyHandles.Num() > 0)
+		{
+			currentBackend->ExecuteWrite([&]()
+			{
+				for (UVRPhysicsHandleComponent* handle : applyHandles) handle->ApplyHandleTransform_AssumesLocked(handle->currentTransform);
+			});
+			INC_DWORD_STAT_BY(STAT_PhysicsHandlesUpdated, applyHandles.Num());
+			INC_DWORD_STAT(STAT_PhysicsHandleSceneWrites);
+		}
+	}
+
+	// Step the backend if it simulates the joints itself.
+	currentBackend->Step(DeltaTime);
+}
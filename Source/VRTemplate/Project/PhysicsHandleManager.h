@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Project/HandlePhysicsBackend.h"
+#include "Globals.h"
+#include "PhysicsHandleManager.generated.h"
+
+/** Define this actors log category. */
+DECLARE_LOG_CATEGORY_EXTERN(LogPhysicsHandleManager, Log, All);
+
+/** Stats group shared by the manager and its backends. */
+DECLARE_STATS_GROUP(TEXT("PhysicsHandleManager"), STATGROUP_PhysicsHandleManager, STATCAT_Advanced);
+
+/** Declare classes used. */
+class UVRPhysicsHandleComponent;
+
+/** The physics backend used by the physics handles. */
+UENUM(BlueprintType)
+enum class EHandlePhysicsBackend : uint8
+{
+	PhysX UMETA(DisplayName = "PhysX", ToolTip = "Use PhysX kinematic targets and D6 joints, pooled in the worlds physics scene."),
+	Mock UMETA(DisplayName = "Mock", ToolTip = "Drive grabbed components on the CPU without a physics scene, for automation tests and benchmarks. Used automatically if the world has no physics scene."),
+};
+
+/** World level service to update the kinematic targets of every VR physics handle in one pass, instead of each handle ticking and taking
+ * its own physics scene lock. Each frame the target transforms of all grabbing handles are worked out on the game thread and then written to the physics scene inside a single write lock. Ticks after the actors owning the handles and their
+ * targets so the targets follow the hands from the same frame. Also owns the physics backend the handles create their joints through.
+ * NOTE: Spawned on demand through Get(), there should only ever be one per world. */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class VRTEMPLATE_API APhysicsHandleManager : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** The physics backend to create joints with. NOTE: Can only be changed with SetBackend while no joints exist. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PhysicsHandleManager")
+	EHandlePhysicsBackend backendType;
+
+	/** Number of kinematic targets and joints to add to the scene when the PhysX backend is created. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PhysicsHandleManager", meta = (ClampMin = "0"))
+	int poolSize;
+
+	/** Max number of kinematic targets and joints to keep when released, any over this are removed from the scene. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PhysicsHandleManager", meta = (ClampMin = "0"))
+	int maxPoolSize;
+
+	/** Enable any debug messages for this class.
+	 * NOTE: Only used when DEVELOPMENT = 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PhysicsHandleManager")
+	bool debug;
+
+private:
+
+	/** Every handle being updated by this manager. */
+	UPROPERTY()
+	TArray<UVRPhysicsHandleComponent*> handles;
+
+	TArray<UVRPhysicsHandleComponent*> activeHandles; /** Re-used list of the handles grabbing something this frame. */
+	TArray<UVRPhysicsHandleComponent*> applyHandles; /** Re-used list of the active handles to move this frame, the rest are moved in physics substeps. */
+	TUniquePtr<IHandlePhysicsBackend> backend; /** The backend joints are created through, created on first use. */
+
+protected:
+
+	/** Level start. Creates the backend. */
+	virtual void BeginPlay() override;
+
+	/** Level end or destroyed. Removes any unused joints and targets from the backend. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Constructor. */
+	APhysicsHandleManager();
+
+	/** Update and apply the targets of each grabbing handle. */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Get the physics handle manager for the given world, spawning one if it doesn't exist yet.
+	 * @Param world, The world to get the service for. */
+	static APhysicsHandleManager* Get(UWorld* world);
+
+	/** Start updating the handle from this manager.
+	 * @Param handle, The handle to register. */
+	void RegisterHandle(UVRPhysicsHandleComponent* handle);
+
+	/** Stop updating the handle from this manager.
+	 * @Param handle, The handle to unregister. */
+	void UnregisterHandle(UVRPhysicsHandleComponent* handle);
+
+	/** Make sure the manager ticks after the given actor and any actor it is attached to, used when a handle starts following a component.
+	 * @Param actor, The actor to tick after. */
+	void AddTickPrerequisites(AActor* actor);
+
+	/** Get the backend to create joints through, creating it if it doesn't exist yet.
+	 * NOTE: Falls back to the mock backend if the world has no physics scene. */
+	IHandlePhysicsBackend* GetBackend();
+
+	/** Change the backend joints are created through, used to run the handles headless in automation tests and benchmarks.
+	 * @Param newBackend, The backend to use.
+	 * @Return false if joints still exist in the current backend, the backend is left unchanged. */
+	UFUNCTION(BlueprintCallable, Category = "PhysicsHandleManager")
+	bool SetBackend(EHandlePhysicsBackend newBackend);
+};
@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/TeleportHeightField.h"
+#include "Components/BoxComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY(LogTeleportHeightField);
+
+/** Every height field that has begun play, in any world. */
+static TArray<TWeakObjectPtr<ATeleportHeightField>> registeredHeightFields;
+
+ATeleportHeightField::ATeleportHeightField()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Box to bake within.
+	bakeBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("BakeBounds"));
+	bakeBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	bakeBounds->SetBoxExtent(FVector(1000.0f, 1000.0f, 500.0f));
+	bakeBounds->bHiddenInGame = true;
+	RootComponent = bakeBounds;
+
+	// Initialise default variables.
+	cellSize = 10.0f;
+	teleportableTypes.Add(EObjectTypeQuery::ObjectTypeQuery9);
+	agentID = 0;
+	searchDistance = 80.0f;
+	heightTolerance = 10.0f;
+	gridOrigin = FVector::ZeroVector;
+	gridSizeX = 0;
+	gridSizeY = 0;
+	bakedCellSize = 0.0f;
+
+#if WITH_EDITOR
+	debug = false;
+#endif
+}
+
+void ATeleportHeightField::BeginPlay()
+{
+	Super::BeginPlay();
+	registeredHeightFields.Add(this);
+
+#if WITH_EDITOR && DEVELOPMENT
+	if (debug) UE_LOG(LogTeleportHeightField, Log, TEXT("Registered %s, %s."), *GetName(), IsBaked() ? TEXT("baked") : TEXT("not baked so it will be ignored"));
+#endif
+}
+
+void ATeleportHeightField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+	registeredHeightFields.Remove(this);
+}
+
+ATeleportHeightField* ATeleportHeightField::Find(UWorld* world)
+{
+	if (!world) return nullptr;
+
+	// Height fields register themselves when they begin play, so ones in levels streamed in later are found without searching the world.
+	for (int32 i = registeredHeightFields.Num() - 1; i >= 0; i--)
+	{
+		ATeleportHeightField* heightField = registeredHeightFields[i].Get();
+		if (!heightField) registeredHeightFields.RemoveAtSwap(i, 1, false);
+		else if (heightField->GetWorld() == world && !heightField->IsPendingKill() && heightField->IsBaked()) return heightField;
+	}
+	return nullptr;
+}
+
+bool ATeleportHeightField::IsBaked() const
+{
+	return gridSizeX > 0 && gridSizeY > 0 && heights.Num() == gridSizeX * gridSizeY && states.Num() == heights.Num();
+}
+
+ETeleportCellState ATeleportHeightField::Lookup(const FVector& location, FVector& outLocation) const
+{
+	if (!IsBaked()) return ETeleportCellState::Unknown;
+
+	// Find the cell, anything outside of the grid is checked at runtime.
+	const int x = FMath::FloorToInt((location.X - gridOrigin.X) / bakedCellSize);
+	const int y = FMath::FloorToInt((location.Y - gridOrigin.Y) / bakedCellSize);
+	if (x < 0 || y < 0 || x >= gridSizeX || y >= gridSizeY) return ETeleportCellState::Unknown;
+	const int index = y * gridSizeX + x;
+	const ETeleportCellState state = states[index];
+	if (state != ETeleportCellState::Valid && state != ETeleportCellState::Invalid) return ETeleportCellState::Unknown;
+
+	// Only use the baked result for locations on the baked floor, anything else such as a table that isn't teleportable is checked at runtime.
+	const float floorHeight = gridOrigin.Z + heights[index];
+	if (FMath::Abs(location.Z - floorHeight) > heightTolerance) return ETeleportCellState::Unknown;
+	outLocation = FVector(location.X, location.Y, floorHeight);
+	return state;
+}
+
+#if WITH_EDITOR
+void ATeleportHeightField::Bake()
+{
+	UWorld* world = GetWorld();
+	CHECK_RETURN(LogTeleportHeightField, !world, "ATeleportHeightField::Bake: No world to bake.");
+	UNavigationSystemV1* navSystem = Cast<UNavigationSystemV1>(world->GetNavigationSystem());
+	CHECK_RETURN(LogTeleportHeightField, !navSystem, "ATeleportHeightField::Bake: No navigation system to bake.");
+
+	// Get the nav data for the same agent as the player.
+	const TArray<FNavDataConfig>& navProps = navSystem->GetSupportedAgents();
+	CHECK_RETURN(LogTeleportHeightField, !navProps.IsValidIndex(agentID), "ATeleportHeightField::Bake: The agentID is out of bounds.");
+	ANavigationData* navData = navSystem->GetNavDataForProps(navProps[agentID]);
+	CHECK_RETURN(LogTeleportHeightField, !navData, "ATeleportHeightField::Bake: No nav data for the agent, build the navigation first.");
+
+	// Size the grid to the bounds.
+	Modify();
+	const FBox bounds = bakeBounds->Bounds.GetBox();
+	bakedCellSize = FMath::Max(cellSize, 1.0f);
+	gridOrigin = bounds.Min;
+	gridSizeX = FMath::Max(FMath::CeilToInt(bounds.GetSize().X / bakedCellSize), 1);
+	gridSizeY = FMath::Max(FMath::CeilToInt(bounds.GetSize().Y / bakedCellSize), 1);
+	heights.SetNumZeroed(gridSizeX * gridSizeY);
+	states.SetNumZeroed(gridSizeX * gridSizeY);
+
+	FCollisionQueryParams params(SCENE_QUERY_STAT(TeleportHeightFieldBake), true, this);
+	FCollisionObjectQueryParams objectParams = FCollisionObjectQueryParams(teleportableTypes);
+	const FVector searchExtent = FVector(searchDistance, searchDistance, searchDistance);
+	TArray<FHitResult> hits;
+	int numValid = 0, numDynamic = 0;
+	for (int y = 0; y < gridSizeY; y++)
+	{
+		for (int x = 0; x < gridSizeX; x++)
+		{
+			const int index = y * gridSizeX + x;
+			const FVector center = gridOrigin + FVector((x + 0.5f) * bakedCellSize, (y + 0.5f) * bakedCellSize, 0.0f);
+
+			// Trace down through the bounds for teleportable floors.
+			world->LineTraceMultiByObjectType(hits, FVector(center.X, center.Y, bounds.Max.Z), FVector(center.X, center.Y, bounds.Min.Z), objectParams, params);
+			if (hits.Num() == 0)
+			{
+				states[index] = ETeleportCellState::Invalid;
+				continue;
+			}
+			const FHitResult& floor = hits[0];
+			heights[index] = (int16)FMath::Clamp(FMath::RoundToInt(floor.Location.Z - gridOrigin.Z), (int)MIN_int16, (int)MAX_int16);
+
+			// Stacked floors can only be told apart at runtime and movable floors may not be there anymore.
+			UPrimitiveComponent* floorComp = floor.GetComponent();
+			if (hits.Num() > 1 || (floorComp && floorComp->Mobility == EComponentMobility::Movable))
+			{
+				states[index] = ETeleportCellState::Dynamic;
+				numDynamic++;
+				continue;
+			}
+
+			// Valid if the floor is on the nav-mesh, if the nav-mesh was found away from the floor it is on an edge so check it at runtime.
+			FNavLocation navLocation;
+			if (!navData->ProjectPoint(floor.Location, navLocation, searchExtent)) states[index] = ETeleportCellState::Invalid;
+			else if (FVector::Dist2D(navLocation.Location, floor.Location) > bakedCellSize * 0.5f)
+			{
+				states[index] = ETeleportCellState::Dynamic;
+				numDynamic++;
+			}
+			else
+			{
+				states[index] = ETeleportCellState::Valid;
+				numValid++;
+			}
+		}
+	}
+
+	UE_LOG(LogTeleportHeightField, Log, TEXT("Baked %s, %d by %d cells, %d valid, %d dynamic."), *GetName(), gridSizeX, gridSizeY, numValid, numDynamic);
+}
+#endif
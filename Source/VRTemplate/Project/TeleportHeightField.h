@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Engine/EngineTypes.h"
+#include "Globals.h"
+#include "TeleportHeightField.generated.h"
+
+/** Define this actors log category. */
+DECLARE_LOG_CATEGORY_EXTERN(LogTeleportHeightField, Log, All);
+
+/** Declare classes used. */
+class UBoxComponent;
+
+/** Baked state of a cell in the teleport height field. */
+UENUM(BlueprintType)
+enum class ETeleportCellState : uint8
+{
+	Invalid UMETA(DisplayName = "Invalid", ToolTip = "The floor of this cell is not on the nav-mesh."),
+	Valid UMETA(DisplayName = "Valid", ToolTip = "The floor of this cell is on the nav-mesh and can be teleported to."),
+	Dynamic UMETA(DisplayName = "Dynamic", ToolTip = "The floor of this cell is movable, layered or on the edge of the nav-mesh so has to be checked at runtime."),
+	Unknown UMETA(Hidden),
+};
+
+/** Grid of floor heights and teleport validity baked from the nav-mesh and teleportable surfaces within the box of this actor, used to
+ * validate teleport locations with a single lookup instead of projecting onto the nav-mesh and tracing down to the floor every frame.
+ * Cells with movable or stacked floors, or on the edge of the nav-mesh, are baked as dynamic and checked at runtime.
+ * NOTE: Press Bake in the details panel after the level or nav-mesh changes, the grid is saved with the level. */
+UCLASS(hidecategories = (Rendering, Replication, Input, LOD, Cooking))
+class VRTEMPLATE_API ATeleportHeightField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Area to bake, the grid is aligned to the world axes. */
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	UBoxComponent* bakeBounds;
+
+	/** Size of each cell in the grid. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HeightField", meta = (ClampMin = "1.0", UIMin = "5.0", UIMax = "100.0"))
+	float cellSize;
+
+	/** Object types of the floors that can be teleported onto. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HeightField")
+	TArray<TEnumAsByte<EObjectTypeQuery>> teleportableTypes;
+
+	/** Index of the nav agent in the project settings to bake the nav-mesh of. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HeightField")
+	int agentID;
+
+	/** Extent to search for the nav-mesh around the floor of each cell. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HeightField")
+	float searchDistance;
+
+	/** Max distance between a looked up location and the baked floor height for the cell to be used. Further locations are checked at runtime. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HeightField")
+	float heightTolerance;
+
+	/** Enable any debug messages for this class.
+	 * NOTE: Only used when DEVELOPMENT = 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HeightField")
+	bool debug;
+
+private:
+
+	/** World location of the corner of the first cell. */
+	UPROPERTY()
+	FVector gridOrigin;
+
+	/** Number of cells along the X axis. */
+	UPROPERTY()
+	int gridSizeX;
+
+	/** Number of cells along the Y axis. */
+	UPROPERTY()
+	int gridSizeY;
+
+	/** Size of the cells the grid was baked with. */
+	UPROPERTY()
+	float bakedCellSize;
+
+	/** Floor height of each cell in centimeters relative to the grid origin. */
+	UPROPERTY()
+	TArray<int16> heights;
+
+	/** State of each cell. */
+	UPROPERTY()
+	TArray<ETeleportCellState> states;
+
+protected:
+
+	/** Level start. Registers this height field so it can be found. */
+	virtual void BeginPlay() override;
+
+	/** Level end or destroyed. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Constructor. */
+	ATeleportHeightField();
+
+	/** Find a baked height field that has begun play in the given world, including ones in streamed levels.
+	 * @Param world, The world to search.
+	 * @Return the height field or null if there isn't one. */
+	static ATeleportHeightField* Find(UWorld* world);
+
+	/** Look up the baked teleport validity at a location.
+	 * @Param location, The location to look up.
+	 * @Param outLocation, The location on the baked floor if valid.
+	 * @Return Valid or Invalid if the baked result can be used, Unknown if the location must be checked at runtime. */
+	ETeleportCellState Lookup(const FVector& location, FVector& outLocation) const;
+
+	/** @Return true if there is baked data. */
+	UFUNCTION(BlueprintPure, Category = "HeightField")
+	bool IsBaked() const;
+
+#if WITH_EDITOR
+	/** Bake the height field from the current level and nav-mesh. */
+	UFUNCTION(CallInEditor, Category = "HeightField")
+	void Bake();
+#endif
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+/** Get the world level service actor of a class, finding the one already in the world or spawning a new transient one. The last service
+ * found is kept for each class, as most calls will be for the same world as the last.
+ * NOTE: Used by the static Get function of each world service, which logs the failure with its own log category.
+ * @Param world, The world to get the service for.
+ * @Return the service, null if the world is null or it could not be spawned. */
+template<typename ServiceClass>
+ServiceClass* GetWorldService(UWorld* world)
+{
+	if (!world) return nullptr;
+
+	// Most calls will be for the same world as the last so check that first.
+	static TWeakObjectPtr<ServiceClass> lastService;
+	if (lastService.IsValid() && lastService->GetWorld() == world && !lastService->IsPendingKill()) return lastService.Get();
+
+	// Find the existing service if there is one.
+	for (TActorIterator<ServiceClass> it(world); it; ++it)
+	{
+		if (!it->IsPendingKill())
+		{
+			lastService = *it;
+			return *it;
+		}
+	}
+
+	// Otherwise spawn a new service.
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	spawnParams.ObjectFlags |= RF_Transient;
+	ServiceClass* service = world->SpawnActor<ServiceClass>(spawnParams);
+	lastService = service;
+	return service;
+}
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/ArcMeshBuilder.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FArcMeshBuilderTest, "VRTemplate.Project.ArcMeshBuilder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FArcMeshBuilderTest::RunTest(const FString& Parameters)
+{
+	FArcMeshBuilder builder;
+	FArcMeshData data;
+
+	// Resampled points are evenly spaced along the path and keep its ends.
+	TArray<FVector> path = { FVector(0.0f, 0.0f, 0.0f), FVector(100.0f, 0.0f, 0.0f), FVector(100.0f, 200.0f, 0.0f) };
+	TArray<FVector> resampled;
+	TestEqual(TEXT("Resample length"), FArcMeshBuilder::Resample(path, 4, resampled), 300.0f);
+	TestEqual(TEXT("Resample count"), resampled.Num(), 4);
+	TestTrue(TEXT("Resample start"), resampled[0].Equals(path[0]));
+	TestTrue(TEXT("Resample spacing"), resampled[1].Equals(FVector(100.0f, 0.0f, 0.0f)));
+	TestTrue(TEXT("Resample end"), resampled.Last().Equals(path.Last()));
+
+	// A path with no length builds nothing.
+	TArray<FVector> point = { FVector(5.0f, 5.0f, 5.0f), FVector(5.0f, 5.0f, 5.0f) };
+	TestFalse(TEXT("Zero length path"), builder.BuildVertices(point, data));
+
+	// Build along a ballistic arc.
+	TArray<FVector> arc;
+	for (int32 i = 0; i < 30; i++)
+	{
+		const float time = i * 0.05f;
+		arc.Add(FVector(1000.0f * time, 0.0f, 300.0f * time - 490.0f * time * time));
+	}
+	builder.BuildTriangles(data);
+	TestTrue(TEXT("Arc built"), builder.BuildVertices(arc, data));
+	TestEqual(TEXT("Vertex count"), data.vertices.Num(), builder.GetNumVertices());
+	TestEqual(TEXT("Triangle count"), data.triangles.Num(), (builder.numRings - 1) * builder.numSides * 6);
+
+	// Every index is in range and every vertex is on the tube around its ring center with a unit normal pointing out.
+	bool indicesValid = true;
+	for (int32 index : data.triangles) indicesValid &= data.vertices.IsValidIndex(index);
+	TestTrue(TEXT("Indices in range"), indicesValid);
+	bool onTube = true;
+	for (int32 i = 0; i < data.vertices.Num(); i++)
+	{
+		const FVector& center = data.ringCenters[i / (builder.numSides + 1)];
+		onTube &= FMath::IsNearlyEqual(FVector::Dist(data.vertices[i], center), builder.radius, 0.001f);
+		onTube &= data.normals[i].IsNormalized() && data.normals[i].Equals((data.vertices[i] - center) / builder.radius, 0.001f);
+	}
+	TestTrue(TEXT("Vertices on the tube"), onTube);
+
+	// Rebuilding along a different path keeps the counts so only the vertex buffer has to be updated.
+	for (FVector& arcPoint : arc) arcPoint.Y += arcPoint.X * 0.5f;
+	TestTrue(TEXT("Arc rebuilt"), builder.BuildVertices(arc, data));
+	TestEqual(TEXT("Rebuilt vertex count"), data.vertices.Num(), builder.GetNumVertices());
+
+	// Time the build, the teleport builds the arc on the game thread every frame while aiming.
+	const int32 iterations = 10000;
+	const double startTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < iterations; i++)
+	{
+		arc[0].X = i * 0.001f;
+		builder.BuildVertices(arc, data);
+	}
+	AddInfo(FString::Printf(TEXT("BuildVertices with %d vertices: %.2f us"), builder.GetNumVertices(), (FPlatformTime::Seconds() - startTime) * 1000000.0 / iterations));
+	return true;
+}
+
+#endif
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/BallisticArc.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBallisticArcTest, "VRTemplate.Project.BallisticArc", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FBallisticArcTest::RunTest(const FString& Parameters)
+{
+	const FBallisticArc arc(FVector(0.0f, 0.0f, 100.0f), FVector(800.0f, 200.0f, 400.0f), -980.0f);
+
+	// Location follows constant acceleration under gravity.
+	TestTrue(TEXT("Start location"), arc.GetLocation(0.0f).Equals(FVector(0.0f, 0.0f, 100.0f)));
+	TestTrue(TEXT("Location after one second"), arc.GetLocation(1.0f).Equals(FVector(800.0f, 200.0f, 10.0f), 0.01f));
+
+	// Every point on the arc between two samples is within the chord error of the line between them, and the error is reached at the middle.
+	const float stepTime = 0.25f;
+	const float chordError = arc.GetChordError(stepTime);
+	bool withinError = true;
+	for (float chordStart = 0.0f; chordStart < 2.0f; chordStart += stepTime)
+	{
+		const FVector a = arc.GetLocation(chordStart);
+		const FVector b = arc.GetLocation(chordStart + stepTime);
+		for (int32 i = 0; i <= 16; i++)
+		{
+			withinError &= FMath::PointDistToSegment(arc.GetLocation(chordStart + stepTime * i / 16.0f), a, b) <= chordError + 0.01f;
+		}
+	}
+	TestTrue(TEXT("Arc within the chord error"), withinError);
+	const FVector middleOffset = arc.GetLocation(stepTime * 0.5f) - (arc.GetLocation(0.0f) + arc.GetLocation(stepTime)) * 0.5f;
+	TestTrue(TEXT("Chord error at the middle"), FMath::IsNearlyEqual(FMath::Abs(middleOffset.Z), chordError, 0.01f));
+	TestEqual(TEXT("No chord error without gravity"), FBallisticArc(FVector::ZeroVector, FVector(100.0f, 0.0f, 0.0f), 0.0f).GetChordError(1.0f), 0.0f);
+
+	// Points are at each step with a final point at the end time.
+	TArray<FVector> points;
+	arc.GetPoints(1.0f, 0.3f, points);
+	TestEqual(TEXT("Point count"), points.Num(), 5);
+	TestTrue(TEXT("Second point"), points[1].Equals(arc.GetLocation(0.3f)));
+	TestTrue(TEXT("Last point"), points.Last().Equals(arc.GetLocation(1.0f)));
+	arc.GetPoints(1.0f, 0.0f, points);
+	TestEqual(TEXT("Zero step point count"), points.Num(), 2);
+
+	// Comparing arcs for reusing the last trace.
+	FBallisticArc moved = arc;
+	moved.start += FVector(0.5f, 0.0f, 0.0f);
+	TestTrue(TEXT("Equal within location tolerance"), arc.IsNearlyEqual(moved, 1.0f, 1.0f));
+	TestFalse(TEXT("Not equal outside location tolerance"), arc.IsNearlyEqual(moved, 0.1f, 1.0f));
+	FBallisticArc turned = arc;
+	turned.velocity = FQuat(FVector::UpVector, FMath::DegreesToRadians(2.0f)).RotateVector(arc.velocity);
+	TestTrue(TEXT("Equal within angle tolerance"), arc.IsNearlyEqual(turned, 1.0f, 3.0f));
+	TestFalse(TEXT("Not equal outside angle tolerance"), arc.IsNearlyEqual(turned, 1.0f, 1.0f));
+	FBallisticArc heavier = arc;
+	heavier.gravity = -1960.0f;
+	TestFalse(TEXT("Not equal with different gravity"), arc.IsNearlyEqual(heavier, 1.0f, 1.0f));
+	return true;
+}
+
+#endif
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/LocomotionIntegrator.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LocomotionIntegratorTest
+{
+	/** Frame rates to replay the input at, they share a frame every ninth of a second. */
+	static const int32 numFrameRates = 3;
+	static const int32 frameRates[numFrameRates] = { 45, 90, 144 };
+
+	/** Number of ninths of a second to replay. */
+	static const int32 numSegments = 9;
+
+	/** Input held for each ninth of a second. Changes are never on a step boundary so every frame rate steps with the same input. */
+	static FVector GetInput(int32 segment)
+	{
+		if (segment < 2) return FVector(1.0f, 0.0f, 0.0f);
+		if (segment < 4) return FVector(0.0f, 1.0f, 0.0f);
+		if (segment < 5) return FVector(0.5f, 0.5f, 0.0f);
+		if (segment < 8) return FVector::ZeroVector;
+		return FVector(-1.0f, 0.0f, 0.0f);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLocomotionIntegratorTest, "VRTemplate.Project.LocomotionIntegrator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FLocomotionIntegratorTest::RunTest(const FString& Parameters)
+{
+	using namespace LocomotionIntegratorTest;
+
+	// Replay the same input stream at each frame rate, recording the position at the end of each ninth of a second.
+	TArray<FVector> positions[numFrameRates];
+	for (int32 rate = 0; rate < numFrameRates; rate++)
+	{
+		const int32 frameRate = frameRates[rate];
+		FLocomotionIntegrator integrator;
+		FVector position = FVector::ZeroVector;
+		for (int32 frame = 0; frame < frameRate * numSegments / 9; frame++)
+		{
+			// Input is gathered during the frame so use the segment the frame started in.
+			position += integrator.Advance(1.0f / frameRate, GetInput(frame * 9 / frameRate));
+			if (((frame + 1) * 9) % frameRate == 0) positions[rate].Add(position);
+		}
+		TestEqual(FString::Printf(TEXT("%d Hz shared frames"), frameRate), positions[rate].Num(), numSegments);
+	}
+
+	// The path is the same at every frame rate.
+	for (int32 rate = 1; rate < numFrameRates; rate++)
+	{
+		for (int32 segment = 0; segment < FMath::Min(positions[0].Num(), positions[rate].Num()); segment++)
+		{
+			TestTrue(FString::Printf(TEXT("%d Hz matches %d Hz at %d/9 seconds"), frameRates[rate], frameRates[0], segment + 1),
+				positions[rate][segment].Equals(positions[0][segment], 0.01f));
+		}
+	}
+
+	// The stream moved somewhere and came to rest before the last segment.
+	TestTrue(TEXT("Moved"), positions[0].Num() == numSegments && positions[0][4].Size() > 10.0f);
+	TestTrue(TEXT("Stopped"), positions[0].Num() == numSegments && positions[0][7].Equals(positions[0][6], 0.01f));
+
+	// A hitch can't move further than the max substeps at max speed.
+	FLocomotionIntegrator integrator;
+	integrator.acceleration = 1000000.0f;
+	const FVector hitchMovement = integrator.Advance(1.0f, FVector(1.0f, 0.0f, 0.0f));
+	TestTrue(TEXT("Hitch capped"), hitchMovement.Size() <= integrator.maxSpeed * integrator.fixedStep * integrator.maxSubsteps + KINDA_SMALL_NUMBER);
+
+	// Clipping removes velocity into a surface, once the step already taken is applied nothing moves.
+	integrator.ClipVelocity(FVector(-1.0f, 0.0f, 0.0f));
+	integrator.Advance(integrator.fixedStep, FVector::ZeroVector);
+	TestTrue(TEXT("Clipped"), integrator.Advance(integrator.fixedStep, FVector::ZeroVector).IsNearlyZero(0.01f));
+
+	// Reset stops straight away.
+	integrator.Advance(1.0f, FVector(1.0f, 0.0f, 0.0f));
+	integrator.Reset();
+	TestTrue(TEXT("Reset"), integrator.Advance(integrator.fixedStep, FVector::ZeroVector).IsNearlyZero());
+	return true;
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Project/NavMeshWalker.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_RECAST
+#include "Detour/DetourNavMeshBuilder.h"
+#include "Detour/DetourNavMeshQuery.h"
+#include "NavMesh/RecastHelpers.h"
+
+/** Cell size of the generated nav-mesh. */
+static const float navCellSize = 10.0f;
+
+/** Build a single tile nav-mesh in recast space from two connected squares covering X 0 to 300, and a third square covering X 320 to 600
+ * with a gap between them, all on the floor and 300 deep. */
+static dtNavMesh* BuildTestNavMesh()
+{
+	// Vertices in cells, X then height then Z.
+	static const unsigned short verts[] = {
+		0, 0, 0,   15, 0, 0,   30, 0, 0,
+		0, 0, 30,  15, 0, 30,  30, 0, 30,
+		32, 0, 0,  60, 0, 0,   60, 0, 30,  32, 0, 30 };
+
+	// Each polygon has its vertices then the polygon across each edge, the first two share the edge at X 150.
+	static const unsigned short none = 0xffff;
+	static const int32 vertsPerPoly = 6;
+	static const unsigned short polys[] = {
+		0, 3, 4, 1, none, none,   none, none, 1, none, none, none,
+		1, 4, 5, 2, none, none,   0, none, none, none, none, none,
+		6, 9, 8, 7, none, none,   none, none, none, none, none, none };
+	static const unsigned short polyFlags[] = { 1, 1, 1 };
+	static const unsigned char polyAreas[] = { 1, 1, 1 };
+
+	dtNavMeshCreateParams params;
+	FMemory::Memzero(params);
+	params.verts = verts;
+	params.vertCount = 10;
+	params.polys = polys;
+	params.polyFlags = polyFlags;
+	params.polyAreas = polyAreas;
+	params.polyCount = 3;
+	params.nvp = vertsPerPoly;
+	params.bmax[0] = 600.0f;
+	params.bmax[1] = navCellSize;
+	params.bmax[2] = 300.0f;
+	params.walkableHeight = 100.0f;
+	params.walkableRadius = 0.0f;
+	params.walkableClimb = navCellSize;
+	params.cs = navCellSize;
+	params.ch = navCellSize;
+	params.buildBvTree = true;
+
+	// The nav-mesh owns and frees the tile data once added.
+	unsigned char* data = nullptr;
+	int dataSize = 0;
+	if (!dtCreateNavMeshData(&params, &data, &dataSize)) return nullptr;
+	dtNavMesh* navMesh = dtAllocNavMesh();
+	if (!navMesh || dtStatusFailed(navMesh->init(data, dataSize, DT_TILE_FREE_DATA)))
+	{
+		dtFree(data);
+		if (navMesh) dtFreeNavMesh(navMesh);
+		return nullptr;
+	}
+	return navMesh;
+}
+
+/** @Return a location on the floor of the generated nav-mesh in unreal space. */
+static FVector TestNavLocation(float x, float z)
+{
+	return Recast2UnrealPoint(FVector(x, 0.0f, z));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNavMeshWalkerTest, "VRTemplate.Project.NavMeshWalker", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FNavMeshWalkerTest::RunTest(const FString& Parameters)
+{
+	dtNavMesh* navMesh = BuildTestNavMesh();
+	if (!TestNotNull(TEXT("Generated nav-mesh"), navMesh)) return false;
+	const dtQueryFilter filter;
+	const FVector extent = FVector(50.0f);
+
+	{
+		// Can't move until placed.
+		FNavMeshWalker walker;
+		TestTrue(TEXT("Init"), walker.Init(navMesh));
+		TestFalse(TEXT("Not placed after init"), walker.IsPlaced());
+		TestFalse(TEXT("Move before placed"), walker.Move(TestNavLocation(100.0f, 100.0f), &filter));
+
+		// Placing snaps down onto the nearest polygon, or fails with no polygon in the extent.
+		TestFalse(TEXT("Place out of range"), walker.Place(TestNavLocation(150.0f, 500.0f), extent, &filter));
+		TestFalse(TEXT("Failed place has no location"), walker.HasLocation());
+		TestTrue(TEXT("Place"), walker.Place(TestNavLocation(50.0f, 50.0f) + FVector(0.0f, 0.0f, 20.0f), extent, &filter));
+		TestTrue(TEXT("Placed on the floor"), walker.GetLocation().Equals(TestNavLocation(50.0f, 50.0f), 0.1f));
+
+		// Moves cross the shared edge between polygons.
+		TestTrue(TEXT("Move across polygons"), walker.Move(TestNavLocation(250.0f, 150.0f), &filter));
+		TestTrue(TEXT("Reached the target"), walker.GetLocation().Equals(TestNavLocation(250.0f, 150.0f), 0.1f));
+
+		// Moves into the gap slide along the edge and never reach the disconnected polygon, even when the target is on it.
+		TestTrue(TEXT("Move into the edge"), walker.Move(TestNavLocation(350.0f, 250.0f), &filter));
+		TestTrue(TEXT("Slid along the edge"), walker.GetLocation().Equals(TestNavLocation(300.0f, 250.0f), 0.1f));
+		TestTrue(TEXT("Move onto the disconnected polygon"), walker.Move(TestNavLocation(450.0f, 150.0f), &filter));
+		TestTrue(TEXT("Stopped at the edge"), walker.GetLocation().Equals(TestNavLocation(300.0f, 150.0f), 0.1f));
+
+		// Placing again at the last location keeps it on the same side of the gap.
+		TestTrue(TEXT("Has location"), walker.HasLocation());
+		TestTrue(TEXT("Place at the last location"), walker.Place(walker.GetLocation(), extent, &filter));
+		TestTrue(TEXT("Still at the edge"), walker.GetLocation().Equals(TestNavLocation(300.0f, 150.0f), 0.1f));
+
+		// Reset clears the polygon and location.
+		walker.Reset();
+		TestFalse(TEXT("Not placed after reset"), walker.IsPlaced());
+		TestFalse(TEXT("No location after reset"), walker.HasLocation());
+	}
+
+	dtFreeNavMesh(navMesh);
+	return true;
+}
+
+#endif
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/VRPhysicsHandleComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPhysicsHandleSmoothingTest, "VRTemplate.Player.PhysicsHandleSmoothing", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPhysicsHandleSmoothingTest::RunTest(const FString& Parameters)
+{
+	const float speed = 10.0f;
+
+	// Snaps with a negative speed and doesn't move without time passing.
+	TestEqual(TEXT("Negative speed snaps"), UVRPhysicsHandleComponent::GetSmoothingAlpha(-1.0f, 0.01f), 1.0f);
+	TestEqual(TEXT("No time no movement"), UVRPhysicsHandleComponent::GetSmoothingAlpha(speed, 0.0f), 0.0f);
+
+	// The gap left after one second is the same at any frame rate, shrinking by a factor of e every 1/speed seconds.
+	const float frameRates[] = { 45.0f, 90.0f, 144.0f };
+	for (const float frameRate : frameRates)
+	{
+		const float alpha = UVRPhysicsHandleComponent::GetSmoothingAlpha(speed, 1.0f / frameRate);
+		float gap = 1.0f;
+		for (int32 frame = 0; frame < FMath::RoundToInt(frameRate); frame++) gap -= gap * alpha;
+		TestTrue(FString::Printf(TEXT("Gap after one second at %.0f Hz"), frameRate), FMath::IsNearlyEqual(gap, FMath::Exp(-speed), 1.0e-5f));
+	}
+	return true;
+}
+
+#endif
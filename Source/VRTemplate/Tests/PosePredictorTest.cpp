@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/PosePredictor.h"
+#include "Project/KinematicHistory.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPosePredictorTest, "VRTemplate.Player.PosePredictor", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPosePredictorTest::RunTest(const FString& Parameters)
+{
+	const float deltaTime = 1.0f / 90.0f;
+	const float predictionTime = 0.02f;
+	FPosePredictor predictor;
+	FKinematicHistory history;
+	FVector location;
+	FQuat rotation;
+
+	// Nothing can be predicted from less than two samples.
+	TestFalse(TEXT("No samples"), predictor.Predict(history, predictionTime, location, rotation));
+	history.AddSample(FVector(10.0f, 0.0f, 0.0f), FQuat::Identity, deltaTime);
+	TestFalse(TEXT("One sample"), predictor.Predict(history, predictionTime, location, rotation));
+	TestEqual(TEXT("One sample returns the newest location"), location, FVector(10.0f, 0.0f, 0.0f));
+
+	// A device moving and turning at a constant speed is predicted along the same path.
+	const FVector linearVelocity(60.0f, -30.0f, 15.0f);
+	const FVector axis = FVector(0.0f, 0.0f, 1.0f);
+	const float angularSpeed = FMath::DegreesToRadians(180.0f);
+	history.Reset();
+	for (int32 i = 0; i < 10; i++)
+	{
+		history.AddSample(linearVelocity * deltaTime * i, FQuat(axis, angularSpeed * deltaTime * i), deltaTime);
+	}
+	const float newestTime = deltaTime * 9;
+	TestTrue(TEXT("Constant velocity predicted"), predictor.Predict(history, predictionTime, location, rotation));
+	TestTrue(TEXT("Constant velocity location"), location.Equals(linearVelocity * (newestTime + predictionTime), 0.01f));
+	TestTrue(TEXT("Constant velocity rotation"), rotation.AngularDistance(FQuat(axis, angularSpeed * (newestTime + predictionTime))) < 0.001f);
+
+	// Prediction time is clamped to the max.
+	predictor.Predict(history, 1.0f, location, rotation);
+	TestTrue(TEXT("Prediction time clamped"), location.Equals(linearVelocity * (newestTime + predictor.maxPredictionTime), 0.01f));
+
+	// A tracking glitch can't throw the prediction further than the max distance and angle from the newest sample.
+	history.Reset();
+	for (int32 i = 0; i < 10; i++)
+	{
+		history.AddSample(FVector::ZeroVector, FQuat::Identity, deltaTime);
+	}
+	const FQuat glitchRotation(axis, PI * 0.5f);
+	history.AddSample(FVector(100.0f, 0.0f, 0.0f), glitchRotation, deltaTime);
+	predictor.Predict(history, predictionTime, location, rotation);
+	TestTrue(TEXT("Glitch distance clamped"), FVector::Dist(location, FVector(100.0f, 0.0f, 0.0f)) <= predictor.maxPredictedDistance + KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Glitch angle clamped"), FMath::RadiansToDegrees(rotation.AngularDistance(glitchRotation)) <= predictor.maxPredictedAngle + 0.01f);
+
+	// Extrapolating with no velocity returns the start pose.
+	FPosePredictor::Extrapolate(FVector(1.0f, 2.0f, 3.0f), glitchRotation, FVector::ZeroVector, FVector::ZeroVector, predictionTime, location, rotation);
+	TestEqual(TEXT("Extrapolate at rest location"), location, FVector(1.0f, 2.0f, 3.0f));
+	TestTrue(TEXT("Extrapolate at rest rotation"), rotation.Equals(glitchRotation));
+	return true;
+}
+
+#endif
@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Player/VRPhysicsHandleComponent.h"
+#include "Project/PhysicsHandleManager.h"
+#include "Project/HandlePhysicsBackend.h"
+#include "Components/BoxComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Frame delta time the handles are updated with. */
+static const float handleTestDeltaTime = 1.0f / 90.0f;
+
+/** A game world that is never ticked, with physics handles on the mock backend updated by ticking the handle manager directly. */
+struct FPhysicsHandleTestWorld
+{
+	UWorld* world; /** The world. */
+	AActor* actor; /** Owns every component added. */
+	APhysicsHandleManager* manager; /** The worlds physics handle manager. */
+	IHandlePhysicsBackend* backend; /** The mock backend of the manager. */
+
+	/** Constructor. Creates and begins play in the world. */
+	FPhysicsHandleTestWorld()
+	{
+		world = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		worldContext.SetCurrentWorld(world);
+		world->InitializeActorsForPlay(FURL());
+		world->BeginPlay();
+		actor = world->SpawnActor<AActor>();
+		manager = APhysicsHandleManager::Get(world);
+		manager->SetBackend(EHandlePhysicsBackend::Mock);
+		backend = manager->GetBackend();
+	}
+
+	/** Destructor. Destroys the world. */
+	~FPhysicsHandleTestWorld()
+	{
+		GEngine->DestroyWorldContext(world);
+		world->DestroyWorld(false);
+	}
+
+	/** @Return a new box component at the location. */
+	UBoxComponent* AddBox(const FVector& location)
+	{
+		UBoxComponent* box = NewObject<UBoxComponent>(actor);
+		box->RegisterComponent();
+		box->SetWorldLocation(location);
+		return box;
+	}
+
+	/** @Return a new physics handle, registered with the manager on begin play. */
+	UVRPhysicsHandleComponent* AddHandle()
+	{
+		UVRPhysicsHandleComponent* handle = NewObject<UVRPhysicsHandleComponent>(actor);
+		handle->RegisterComponent();
+		return handle;
+	}
+
+	/** Update every handle and step the backend for a number of frames. */
+	void Tick(int32 frames)
+	{
+		for (int32 i = 0; i < frames; i++) manager->Tick(handleTestDeltaTime);
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRPhysicsHandleComponentTest, "VRTemplate.Player.VRPhysicsHandleComponent", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FVRPhysicsHandleComponentTest::RunTest(const FString& Parameters)
+{
+	FPhysicsHandleTestWorld testWorld;
+	IHandlePhysicsBackend* backend = testWorld.backend;
+	if (!TestNotNull(TEXT("Backend"), backend)) return false;
+	UBoxComponent* grabbed = testWorld.AddBox(FVector::ZeroVector);
+	UBoxComponent* target = testWorld.AddBox(FVector::ZeroVector);
+	UVRPhysicsHandleComponent* firstHandle = testWorld.AddHandle();
+	UVRPhysicsHandleComponent* secondHandle = testWorld.AddHandle();
+
+	// Creating and destroying a joint adds and removes it from the backend.
+	firstHandle->CreateJointAndFollowLocation(grabbed, target, NAME_None, FVector::ZeroVector);
+	TestTrue(TEXT("Joint created"), firstHandle->IsJointActive());
+	TestEqual(TEXT("One joint in the backend"), backend->GetNumActiveJoints(), 1);
+	firstHandle->DestroyJoint();
+	TestFalse(TEXT("Joint destroyed"), firstHandle->IsJointActive());
+	TestEqual(TEXT("No joints in the backend"), backend->GetNumActiveJoints(), 0);
+
+	// The next joint created reuses the pooled slot, a joint created while its in use gets another.
+	const FVector secondGrabLocation = FVector(0.0f, 0.0f, 10.0f);
+	secondHandle->CreateJointAndFollowLocation(grabbed, target, NAME_None, secondGrabLocation);
+	TestTrue(TEXT("Pooled joint reused"), backend->GetTargetPose_AssumesLocked(0).GetLocation().Equals(secondGrabLocation));
+	firstHandle->CreateJointAndFollowLocation(grabbed, target, NAME_None, FVector::ZeroVector);
+	TestEqual(TEXT("Two joints in the backend"), backend->GetNumActiveJoints(), 2);
+	TestTrue(TEXT("New joint in the next slot"), backend->GetTargetPose_AssumesLocked(1).GetLocation().Equals(FVector::ZeroVector));
+	secondHandle->DestroyJoint();
+
+	// Dragging the target pulls the grabbed component to it.
+	const FVector dragLocation = FVector(100.0f, 50.0f, 0.0f);
+	target->SetWorldLocation(dragLocation);
+	testWorld.Tick(2 * FMath::RoundToInt(1.0f / handleTestDeltaTime));
+	TestTrue(TEXT("Grabbed component reached the target"), grabbed->GetComponentLocation().Equals(dragLocation, 0.5f));
+
+	// Releasing clears the joint and the component is no longer pulled.
+	firstHandle->DestroyJoint();
+	TestFalse(TEXT("Joint released"), firstHandle->IsJointActive());
+	TestEqual(TEXT("No joints after release"), backend->GetNumActiveJoints(), 0);
+	target->SetWorldLocation(FVector::ZeroVector);
+	testWorld.Tick(10);
+	TestTrue(TEXT("Released component stays put"), grabbed->GetComponentLocation().Equals(dragLocation, 0.5f));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRPhysicsHandleComponentBenchmark, "VRTemplate.Player.VRPhysicsHandleComponentBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FVRPhysicsHandleComponentBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 numHandles = 64;
+	const int32 numFrames = 90;
+	const int32 numRuns = 10;
+	FPhysicsHandleTestWorld testWorld;
+	UBoxComponent* target = testWorld.AddBox(FVector::ZeroVector);
+	TArray<UBoxComponent*> grabbed;
+	TArray<UVRPhysicsHandleComponent*> handles;
+	for (int32 i = 0; i < numHandles; i++)
+	{
+		grabbed.Add(testWorld.AddBox(FVector(0.0f, i * 10.0f, 0.0f)));
+		handles.Add(testWorld.AddHandle());
+	}
+
+	// Grab, drag for a second and release every handle, timing each part.
+	double createTime = 0.0, updateTime = 0.0, destroyTime = 0.0;
+	for (int32 run = 0; run < numRuns; run++)
+	{
+		double startTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < numHandles; i++) handles[i]->CreateJointAndFollowLocation(grabbed[i], target, NAME_None, grabbed[i]->GetComponentLocation());
+		createTime += FPlatformTime::Seconds() - startTime;
+		TestEqual(TEXT("Every handle grabbing"), testWorld.backend->GetNumActiveJoints(), numHandles);
+
+		startTime = FPlatformTime::Seconds();
+		for (int32 frame = 0; frame < numFrames; frame++)
+		{
+			target->SetWorldLocation(FVector(frame, 0.0f, 0.0f));
+			testWorld.Tick(1);
+		}
+		updateTime += FPlatformTime::Seconds() - startTime;
+
+		startTime = FPlatformTime::Seconds();
+		for (UVRPhysicsHandleComponent* handle : handles) handle->DestroyJoint();
+		destroyTime += FPlatformTime::Seconds() - startTime;
+		TestEqual(TEXT("Every handle released"), testWorld.backend->GetNumActiveJoints(), 0);
+	}
+
+	AddInfo(FString::Printf(TEXT("%d handles: create %.2f us, update %.2f us per frame, destroy %.2f us."), numHandles,
+		createTime * 1.0e6 / numRuns, updateTime * 1.0e6 / (numRuns * numFrames), destroyTime * 1.0e6 / numRuns));
+	return true;
+}
+
+#endif
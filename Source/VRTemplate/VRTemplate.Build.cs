@@ -9,7 +9,7 @@ public class VRTemplate : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
         PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore" , "InputDevice" , "HeadMountedDisplay", "NavigationSystem", "AIModule",
-            "UMG", "Slate", "SlateCore", "RenderCore", "ApplicationCore", "Paper2D", "LevelSequence", "ActorSequence" , "MovieScene", "PhysicsCore", "PhysX" , "APEX",  "GameplayTasks"});
+            "UMG", "Slate", "SlateCore", "RenderCore", "ApplicationCore", "Paper2D", "LevelSequence", "ActorSequence" , "MovieScene", "PhysicsCore", "PhysX" , "APEX",  "GameplayTasks", "ProceduralMeshComponent", "Navmesh"});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore", "RenderCore", "HeadMountedDisplay", "SteamVR" });
 	}